@@ -0,0 +1,20 @@
+import os
+import json
+
+#################################################################
+# Reader for the JSON lines stats exported by the sweep drivers'
+# gem5 runs (see --stats-export), shared by rpm-cli.py and
+# eradicate-cli.py
+#################################################################
+
+# Last stat dump of a run, keyed by the stat name without its object
+# path. Empty if the run did not get to dump its stats.
+def readStats(statFile):
+    stats = {}
+    if os.path.exists(statFile):
+        with open(statFile, "r") as f:
+            lines = [line for line in f if line.strip()]
+        if lines:
+            for name, value in json.loads(lines[-1]).items():
+                stats[name.split('.')[-1]] = value
+    return stats
@@ -29,8 +29,8 @@
 import m5
 from m5.objects import *
 from m5.defines import buildEnv
-from m5.util import addToPath
-import os, argparse, sys
+from m5.util import addToPath, convert
+import os, argparse, csv, sys
 
 addToPath('../')
 
@@ -81,6 +81,54 @@ parser.add_argument("--inj-vnet", type=int, default=-1,
                         0 and 1 are 1-flit, 2 is 5-flit.\
                         Set to -1 to inject randomly in all vnets.")
 
+parser.add_argument("--multicast-fraction", type=float, default=0.0,
+                    help="Fraction of packets sent to a set of destinations.\
+                        Needs --rpm-packet-type=3.")
+
+parser.add_argument("--broadcast-fraction", type=float, default=0.0,
+                    help="Fraction of packets sent to every destination.\
+                        Needs --rpm-packet-type=3.")
+
+parser.add_argument("--multicast-dests-min", type=int, default=2,
+                    help="Smallest multicast destination set")
+
+parser.add_argument("--multicast-dests-max", type=int, default=16,
+                    help="Largest multicast destination set")
+
+parser.add_argument("--multicast-dests-dist", default="uniform",
+                    choices=['uniform', 'geometric'],
+                    help="Distribution of the multicast destination set\
+                        size. geometric makes every extra destination\
+                        half as likely.")
+
+parser.add_argument("--hotspot-fraction", type=float, default=0.0,
+                    help="Fraction of packets that go to --hotspot-dest-id")
+
+parser.add_argument("--hotspot-dest-id", type=int, default=0,
+                    help="Hotspot destination")
+
+parser.add_argument("--sweep-rates", default=None,
+                    help="Measure these injection rates in one run, given\
+                        as start:stop:step or a comma-separated list.\
+                        Results go to sweep.csv in the output directory.")
+
+parser.add_argument("--sweep-warmup-cycles", type=int, default=10000,
+                    help="Cycles simulated once before the first rate")
+
+parser.add_argument("--sweep-sample-cycles", type=int, default=2000,
+                    help="Cycles per latency sample within a rate")
+
+parser.add_argument("--sweep-max-samples", type=int, default=50,
+                    help="Samples after which a rate counts as unstable")
+
+parser.add_argument("--sweep-tolerance", type=float, default=0.02,
+                    help="Relative latency change between two samples\
+                        below which a rate is in steady state")
+
+parser.add_argument("--sweep-saturation", type=float, default=3.0,
+                    help="Stop the sweep once latency exceeds this many\
+                        times the latency of the first rate")
+
 #
 # Add the ruby specific and protocol specific options
 #
@@ -92,11 +140,18 @@ cpus = [ GarnetSyntheticTraffic(
                      num_packets_max=args.num_packets_max,
                      single_sender=args.single_sender_id,
                      single_dest=args.single_dest_id,
-                     sim_cycles=args.sim_cycles,
+                     sim_cycles=-1 if args.sweep_rates else args.sim_cycles,
                      traffic_type=args.synthetic,
                      inj_rate=args.injectionrate,
                      inj_vnet=args.inj_vnet,
                      precision=args.precision,
+                     multicast_fraction=args.multicast_fraction,
+                     broadcast_fraction=args.broadcast_fraction,
+                     multicast_dests_min=args.multicast_dests_min,
+                     multicast_dests_max=args.multicast_dests_max,
+                     multicast_dests_dist=args.multicast_dests_dist,
+                     hotspot_fraction=args.hotspot_fraction,
+                     hotspot_dest=args.hotspot_dest_id,
                      num_dest=args.num_dirs) \
          for i in range(args.num_cpus) ]
 
@@ -122,6 +177,8 @@ for ruby_port in system.ruby._cpu_ports:
      # Tie the cpu test ports to the ruby cpu port
      #
      cpus[i].test = ruby_port.in_ports
+     if args.garnet_partitions > 1:
+         cpus[i].eventq_index = ruby_port.eventq_index
      i += 1
 
 # -----------------------
@@ -134,10 +191,102 @@ root.system.mem_mode = 'timing'
 # Not much point in this being higher than the L1 latency
 m5.ticks.setGlobalFrequency('1ps')
 
+ruby_period = round(1e12 / convert.toFrequency(args.ruby_clock))
+
+if args.garnet_partitions > 1:
+    # A flit or credit crossing partitions must arrive after the next
+    # barrier, so the quantum stays one tick below the link latency.
+    root.sim_quantum = args.link_latency * ruby_period - 1
+    # Take in the flits and credits of a quantum by source tile, not in
+    # the order the host threads got to the barrier
+    root.deterministic_quanta = True
+
+def parse_rates(spec):
+    if ':' in spec:
+        start, stop, step = (float(x) for x in spec.split(':'))
+        num = int(round((stop - start) / step)) + 1
+        return [round(start + i * step, 6) for i in range(num)]
+    return [float(x) for x in spec.split(',')]
+
+def sweep(rates, network):
+    """Warm up once, then run each rate until its latency settles.
+    Stops after the first rate that saturates the network."""
+
+    def totals():
+        return (network.getPacketsInjected(),
+                network.getPacketsReceived(),
+                network.getPacketLatency())
+
+    def simulate(cycles):
+        exit_event = m5.simulate(cycles * ruby_period)
+        return exit_event.getCause() == "simulate() limit reached"
+
+    for cpu in cpus:
+        cpu.setInjRate(rates[0])
+    if not simulate(args.sweep_warmup_cycles):
+        return []
+
+    results = []
+    zero_load = None
+    for rate in rates:
+        for cpu in cpus:
+            cpu.setInjRate(rate)
+
+        # Latency of each sample, from the packet totals at its start
+        start = totals()
+        prev_latency = None
+        settled = False
+        for sample in range(args.sweep_max_samples):
+            if not simulate(args.sweep_sample_cycles):
+                return results
+            end = totals()
+            injected = end[0] - start[0]
+            received = end[1] - start[1]
+            latency = (end[2] - start[2]) / received / ruby_period \
+                if received else float('inf')
+            if prev_latency is not None and \
+               abs(latency - prev_latency) <= \
+               args.sweep_tolerance * prev_latency:
+                settled = True
+                break
+            prev_latency = latency
+            start = end
+
+        if zero_load is None:
+            zero_load = latency
+        saturated = not settled or \
+            latency > args.sweep_saturation * zero_load
+        results.append({
+            'injection_rate': rate,
+            'latency': latency,
+            'effective_injection_rate':
+                injected / len(cpus) / args.sweep_sample_cycles,
+            'received_rate': received / len(cpus) / args.sweep_sample_cycles,
+            'injected_packets': injected,
+            'samples': sample + 1,
+            'saturated': int(saturated),
+        })
+        print('rate %.3f: latency %.2f cycles after %d samples%s' %
+              (rate, latency, sample + 1, ' (saturated)' if saturated else ''))
+        if saturated:
+            break
+    return results
+
 # instantiate configuration
 m5.instantiate()
 
-# simulate until program terminates
-exit_event = m5.simulate(args.abs_max_tick)
+if args.sweep_rates:
+    results = sweep(parse_rates(args.sweep_rates), system.ruby.network)
+    with open(os.path.join(m5.options.outdir, 'sweep.csv'), 'w') as f:
+        writer = csv.DictWriter(f, fieldnames=[
+            'injection_rate', 'latency', 'effective_injection_rate',
+            'received_rate', 'injected_packets', 'samples', 'saturated'])
+        writer.writeheader()
+        writer.writerows(results)
+    print('Exiting @ tick', m5.curTick(), 'after sweeping', len(results),
+          'injection rates')
+else:
+    # simulate until program terminates
+    exit_event = m5.simulate(args.abs_max_tick)
 
-print('Exiting @ tick', m5.curTick(), 'because', exit_event.getCause())
+    print('Exiting @ tick', m5.curTick(), 'because', exit_event.getCause())
@@ -268,4 +268,6 @@ if args.wait_gdb:
     system.workload.wait_for_remote_gdb = True
 
 root = Root(full_system = False, system = system)
+if args.ruby:
+    Ruby.setup_quantum(args, root)
 Simulation.run(args, root, system, FutureClass)
@@ -94,7 +94,46 @@ def define_options(parser):
         help="""types of rpm packetself.
         0: single destination packet based on memory addressself.
         1: multicast packet.
-        2: broadcast packet. Every packet is broadcast.""")
+        2: broadcast packet. Every packet is broadcast.
+        3: destinations picked by the synthetic traffic generator.""")
+    parser.add_argument(
+        "--rpm-setaside-depth", action="store", type=int, default=16,
+        help="""replicas each rpm set-aside buffer can hold""")
+    parser.add_argument(
+        "--garnet-switch-allocator", action="store", type=str,
+        default="separable", choices=["separable", "bitset"],
+        help="""switch allocator of the garnet routers.
+        separable: loop over the input VCs and inports.
+        bitset: the same grants, picked from packed request masks.""")
+    parser.add_argument(
+        "--garnet-partitions", action="store", type=int, default=1,
+        help="""split a garnet mesh into this many tiles, each simulated
+        on its own event queue and host thread. Needs a sim_quantum
+        shorter than the link latency. Flits and credits that arrive
+        in the same tick from different tiles are only taken in by
+        source tile with root.deterministic_quanta set, which
+        garnet_synth_traffic.py and --ruby-parallel-cores do; otherwise
+        they arrive in host thread order.""")
+    parser.add_argument(
+        "--rpm-setaside-arbitration", action="store", type=str,
+        default="round_robin", choices=["round_robin", "age"],
+        help="""how rpm set-aside replicas compete with input VCs.
+        round_robin: rotate over all inports.
+        age: the oldest requesting flit wins the outport.""")
+    parser.add_argument(
+        "--multicast-routing", action="store", type=str,
+        default="rpm", choices=["rpm", "xy_tree", "dual_path", "unicast"],
+        help="""how an rpm network routes multicast packets.
+        rpm: recursive partitioning.
+        xy_tree: XY routes replicated where they diverge.
+        dual_path: two packets along a Hamiltonian path of the mesh.
+        unicast: one packet per destination.""")
+    parser.add_argument(
+        "--stats-export", action="append", type=str, default=[],
+        metavar="URL",
+        help="""extra stat output next to stats.txt, e.g.
+        jsonl://net.jsonl?filter='network\\.'. May be repeated. See
+        --stats-help for the csv and jsonl formats.""")
 
 def create_network(options, ruby):
 
@@ -143,6 +182,14 @@ def init_network(options, network, InterfaceClass):
         network.garnet_deadlock_threshold = options.garnet_deadlock_threshold
         network.trace_packet_id = options.trace_packet_id
         network.enable_rpm = options.enable_rpm
+        for router in network.routers:
+            router.switch_allocator = options.garnet_switch_allocator
+        if options.enable_rpm:
+            network.multicast_routing = options.multicast_routing
+            for router in network.routers:
+                router.setaside_depth = options.rpm_setaside_depth
+                router.setaside_arbitration = \
+                    options.rpm_setaside_arbitration
 
         # Create Bridges and connect them to the corresponding links
         for intLink in network.int_links:
@@ -216,7 +263,64 @@ def init_network(options, network, InterfaceClass):
                   for (i,n) in enumerate(network.ext_links)]
         network.netifs = netifs
 
+    if options.garnet_partitions > 1:
+        partition_network(options, network)
+
+    for url in options.stats_export:
+        m5.stats.addStatVisitor(url)
+
     if options.network_fault_model:
         assert(options.network == "garnet")
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+def partition_network(options, network):
+    """Place each tile of the mesh on its own event queue, together with
+    the NIs, controllers and links attached to its routers. A link
+    between two tiles runs on the queue of the node that feeds it."""
+
+    if options.network != "garnet" or options.mesh_rows <= 0:
+        fatal("--garnet-partitions needs a garnet mesh (--mesh-rows)")
+
+    num_parts = options.garnet_partitions
+    rows = options.mesh_rows
+    cols = len(network.routers) // rows
+
+    # As square a grid of tiles as num_parts allows
+    tile_rows = max(d for d in range(1, num_parts + 1)
+                    if num_parts % d == 0 and d * d <= num_parts)
+    tile_cols = num_parts // tile_rows
+    if tile_rows > rows or tile_cols > cols:
+        fatal("Cannot split a %dx%d mesh into %d tiles" %
+              (rows, cols, num_parts))
+
+    def partition(router):
+        y, x = router.router_id // cols, router.router_id % cols
+        return (y * tile_rows // rows) * tile_cols + x * tile_cols // cols
+
+    for router in network.routers:
+        router.eventq_index = partition(router)
+
+    for link in network.int_links:
+        src = partition(link.src_node)
+        dst = partition(link.dst_node)
+        # Flits leave the source, credits leave the destination
+        link.network_link.eventq_index = src
+        link.src_net_bridge.eventq_index = src
+        link.src_cred_bridge.eventq_index = src
+        link.credit_link.eventq_index = dst
+        link.dst_net_bridge.eventq_index = dst
+        link.dst_cred_bridge.eventq_index = dst
+
+    for (i, link) in enumerate(network.ext_links):
+        part = partition(link.int_node)
+        for obj in list(link.network_links) + list(link.credit_links) + \
+                   list(link.ext_net_bridge) + list(link.ext_cred_bridge) + \
+                   list(link.int_net_bridge) + list(link.int_cred_bridge):
+            obj.eventq_index = part
+        network.netifs[i].eventq_index = part
+        link.ext_node.eventq_index = part
+        # Set explicitly so that a tester can follow its sequencer
+        sequencer = getattr(link.ext_node, "sequencer", None)
+        if isinstance(sequencer, SimObject):
+            sequencer.eventq_index = part
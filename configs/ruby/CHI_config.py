@@ -190,7 +190,8 @@ class CHI_Cache_Controller(Cache_Controller):
             retryTriggerQueue = OrderedTriggerMessageBuffer(),
             replTriggerQueue = OrderedTriggerMessageBuffer(),
             reqRdy = TriggerMessageBuffer(),
-            snpRdy = TriggerMessageBuffer())
+            snpRdy = TriggerMessageBuffer(),
+            flushQueue = TriggerMessageBuffer())
         # Set somewhat large number since we really a lot on internal
         # triggers. To limit the controller performance, tweak other
         # params such as: input port buffer size, cache banks, and output
@@ -54,6 +54,8 @@ def define_options(parser):
     parser.add_argument("--l0_transitions_per_cycle", type=int, default=32)
     parser.add_argument("--l1_transitions_per_cycle", type=int, default=32)
     parser.add_argument("--l2_transitions_per_cycle", type=int, default=4)
+    parser.add_argument("--flush-bulk", action="store_true",
+        help="Acknowledge each L2 bank's slice of a CLFLUSH range once")
     parser.add_argument(
         "--enable-prefetch", action="store_true", default=False,
         help="Enable Ruby hardware prefetcher")
@@ -195,6 +197,7 @@ def create_system(options, full_system, system, dma_ports, bootmem,
                         L2cache = l2_cache, cluster_id = i,
                         transitions_per_cycle =\
                          options.l2_transitions_per_cycle,
+                        flush_bulk = options.flush_bulk,
                         ruby_system = ruby_system)
 
             exec("ruby_system.l2_cntrl%d = l2_cntrl"
@@ -216,6 +219,11 @@ def create_system(options, full_system, system, dma_ports, bootmem,
             l2_cntrl.responseToL2Cache = MessageBuffer()
             l2_cntrl.responseToL2Cache.in_port = ruby_system.network.out_port
 
+            l2_cntrl.flushReqL2ToL2Out = MessageBuffer()
+            l2_cntrl.flushReqL2ToL2Out.out_port = ruby_system.network.in_port
+            l2_cntrl.flushReqL2ToL2In = MessageBuffer()
+            l2_cntrl.flushReqL2ToL2In.in_port = ruby_system.network.out_port
+
     # Run each of the ruby memory controllers at a ratio of the frequency of
     # the ruby system
     # clk_divider value is a fix to pass regression.
@@ -323,6 +331,6 @@ def create_system(options, full_system, system, dma_ports, bootmem,
                                             cpus = [n for n in range(i*num_cpus_per_cluster, \
                                                                      (i+1)*num_cpus_per_cluster)])
 
-    ruby_system.network.number_of_virtual_networks = 3
+    ruby_system.network.number_of_virtual_networks = 4
     topology = create_topology(all_cntrls, options)
     return (cpu_sequencers, mem_dir_cntrl_nodes, topology)
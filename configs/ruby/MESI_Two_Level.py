@@ -39,7 +39,13 @@ class L1Cache(RubyCache): pass
 class L2Cache(RubyCache): pass
 
 def define_options(parser):
-    return
+    parser.add_argument("--flush-engine", action="store_true",
+          help="Walk multi-line CLFLUSH requests with the L1 flush engine")
+    parser.add_argument("--flush-engine-width", type=int, default=4,
+          help="Cache lines the L1 flush engine issues per cycle")
+    parser.add_argument("--flush-bulk", action="store_true",
+          help="Let each L2 bank walk its slice of a CLFLUSH and "
+               "acknowledge it once (incompatible with --flush-engine)")
 
 def create_system(options, full_system, system, dma_ports, bootmem,
                   ruby_system, cpus):
@@ -47,6 +53,10 @@ def create_system(options, full_system, system, dma_ports, bootmem,
     if buildEnv['PROTOCOL'] != 'MESI_Two_Level':
         fatal("This script requires the MESI_Two_Level protocol to be built.")
 
+    if options.flush_engine and options.flush_bulk:
+        fatal("--flush-engine and --flush-bulk cannot be combined; bulk "
+              "flushes are walked by the L2 banks, not the L1 engine.")
+
     cpu_sequencers = []
 
     #
@@ -90,7 +100,11 @@ def create_system(options, full_system, system, dma_ports, bootmem,
                                       ruby_system = ruby_system,
                                       clk_domain = clk_domain,
                                       transitions_per_cycle = options.ports,
-                                      enable_prefetch = False)
+                                      enable_prefetch = False,
+                                      flush_engine = options.flush_engine,
+                                      flush_engine_width =
+                                          options.flush_engine_width,
+                                      flush_bulk = options.flush_bulk)
 
         cpu_seq = RubySequencer(version = i,
                                 dcache = l1d_cache, clk_domain = clk_domain,
@@ -125,6 +139,8 @@ def create_system(options, full_system, system, dma_ports, bootmem,
         l1_cntrl.flushReqL1ToL1In = MessageBuffer()
         l1_cntrl.flushReqL1ToL1In.in_port = ruby_system.network.out_port
 
+        l1_cntrl.flushEngineQueue = MessageBuffer(allow_zero_latency = True)
+
     l2_index_start = block_size_bits + l2_bits
 
     for i in range(options.num_l2caches):
@@ -138,6 +154,7 @@ def create_system(options, full_system, system, dma_ports, bootmem,
         l2_cntrl = L2Cache_Controller(version = i,
                                       L2cache = l2_cache,
                                       transitions_per_cycle = options.ports,
+                                      flush_bulk = options.flush_bulk,
                                       ruby_system = ruby_system)
 
         exec("ruby_system.l2_cntrl%d = l2_cntrl" % i)
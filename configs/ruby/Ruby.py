@@ -41,7 +41,7 @@ import math
 import m5
 from m5.objects import *
 from m5.defines import buildEnv
-from m5.util import addToPath, fatal
+from m5.util import addToPath, convert, fatal
 
 addToPath('../')
 
@@ -94,6 +94,29 @@ def define_options(parser):
         "--recycle-latency", type=int, default=10,
         help="Recycle latency for ruby controller input buffers")
 
+    parser.add_argument(
+        "--ruby-cache-tag-index", action="store", default="hash_map",
+        choices=["hash_map", "set_array"],
+        help="how ruby caches look up tags. set_array scans the tags "
+        "of one set, kept next to each other, instead of a hash map "
+        "for the whole cache")
+
+    parser.add_argument(
+        "--ruby-parallel-cores", action="store_true", default=False,
+        help="run each core with its sequencer and L1 controller on its "
+        "own event queue and host thread (SE mode). Messages between the "
+        "L1s and the network are handed over at quantum barriers")
+    parser.add_argument(
+        "--ruby-quantum", action="store", type=int, default=1,
+        help="quantum of --ruby-parallel-cores in Ruby cycles. Messages "
+        "that take fewer cycles into another queue arrive late")
+    parser.add_argument(
+        "--deterministic-quanta", action="store_true", default=False,
+        help="hand over what crosses between event queues in queue "
+        "order, which makes parallel runs reproducible. The queues still "
+        "share one random number generator, so this cannot be combined "
+        "with Ruby randomization, random replacement or adaptive routing")
+
     protocol = buildEnv['PROTOCOL']
     exec("from . import %s" % protocol)
     eval("%s.define_options(parser)" % protocol)
@@ -206,6 +229,10 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
         print("Error: could not create sytem for ruby protocol %s" % protocol)
         raise
 
+    for cache in ruby.descendants():
+        if isinstance(cache, RubyCache):
+            cache.tag_index = options.ruby_cache_tag_index
+
     # Create the network topology
     topology.makeTopology(options, network, IntLinkClass, ExtLinkClass,
             RouterClass)
@@ -218,6 +245,12 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
     # Initialize network based on topology
     Network.init_network(options, network, InterfaceClass)
 
+    if options.ruby_parallel_cores:
+        if full_system:
+            fatal("--ruby-parallel-cores supports SE mode only, the devices "
+                  "of a full system are reached through direct port calls")
+        place_cores(ruby, cpus, cpu_sequencers)
+
     # Create a port proxy for connecting the system port. This is
     # independent of the protocol and kept in the protocol-agnostic
     # part (i.e. here).
@@ -249,6 +282,64 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
         ruby.phys_mem = SimpleMemory(range=system.mem_ranges[0],
                                      in_addr_map=False)
 
+def place_cores(ruby, cpus, cpu_sequencers):
+    """Move each core, the controller of its sequencer and everything
+    below them to the event queue of the core. The shared caches,
+    directories and the network stay on queue 0."""
+
+    controllers = {}
+    for obj in ruby.descendants():
+        sequencer = getattr(obj, "sequencer", None)
+        if isinstance(sequencer, SimObject):
+            controllers[id(sequencer)] = obj
+
+    for (i, cpu_seq) in enumerate(cpu_sequencers):
+        if id(cpu_seq) not in controllers:
+            fatal("No controller found for sequencer %d" % i)
+        controllers[id(cpu_seq)].eventq_index = i + 1
+        cpu_seq.eventq_index = i + 1
+        cpus[i].eventq_index = i + 1
+
+def setup_quantum(options, root):
+    """Set the quantum of a --ruby-parallel-cores run one tick below the
+    --ruby-quantum cycles, so a message into another queue that takes at
+    least that many cycles arrives after the barrier handing it over."""
+
+    if not options.ruby_parallel_cores:
+        return
+
+    # in the default 1ps ticks
+    ruby_period = round(1e12 / convert.toFrequency(options.ruby_clock))
+    cycles = options.ruby_quantum
+    if options.garnet_partitions > 1:
+        cycles = min(cycles, options.link_latency)
+    root.sim_quantum = cycles * ruby_period - 1
+    # Garnet tiles hand their flits over in source tile order regardless
+    root.deterministic_quanta = options.deterministic_quanta or \
+                                options.garnet_partitions > 1
+    if options.deterministic_quanta:
+        check_deterministic(root)
+
+def check_deterministic(root):
+    """Reject what draws from the random number generator shared by all
+    event queues. The queues would race for its numbers, so the run would
+    not be reproducible despite --deterministic-quanta."""
+
+    for obj in root.descendants():
+        if isinstance(obj, RubySystem) and obj.randomization:
+            fatal("--deterministic-quanta cannot be used with Ruby "
+                  "randomization")
+        if isinstance(obj, MessageBuffer) and \
+           str(obj.randomization) == 'enabled':
+            fatal("--deterministic-quanta cannot be used with randomized "
+                  "message buffer %s" % obj.path())
+        if isinstance(obj, RandomRP):
+            fatal("--deterministic-quanta cannot be used with random "
+                  "replacement in %s" % obj.path())
+        if isinstance(obj, SimpleNetwork) and obj.adaptive_routing:
+            fatal("--deterministic-quanta cannot be used with adaptive "
+                  "routing, which breaks ties at random")
+
 def create_directories(options, bootmem, ruby_system, system):
     dir_cntrl_nodes = []
     for i in range(options.num_dirs):
@@ -19,9 +19,15 @@ import numpy as np
 import matplotlib.pyplot as plt
 import concurrent.futures
 from collections import OrderedDict
+from cli_stats import readStats
 
 progName='ERADICATE-CLI'
 
+#################################################################
+# Stats the gem5 runs export as JSON lines, one record per stat dump
+#################################################################
+statsExport = "jsonl://stats.jsonl?filter='^simTicks'"
+
 #################################################################
 # Data class for each throughput simulation
 #################################################################
@@ -46,6 +52,7 @@ class EradicateCLI:
 
         self.cwd                = os.getcwd()
         self.opt                = args.opt
+        self.protocol           = args.protocol
         self.benchmarks         = args.benchmarks
         self.flushTypeList      = args.flush_type
         self.flushNumList       = args.flush_num
@@ -174,14 +181,8 @@ class EradicateCLI:
                 plt.savefig(f'{self.outdirRoot}/{bench}-{meshRows}x{meshRows}.png')
 
     def getStats(self, params):
-        simCycles = 0
-        with open(params.statFile, "r") as f:
-            for line in f:
-                if 'simTicks' in line:
-                    line = " ".join(line.strip().split())
-                    simCycles = float(line.split(' ')[1]) / 500.0
-                    params.simCycles = simCycles
-
+        stats = readStats(params.statFile)
+        params.simCycles = (stats.get('simTicks') or 0) / 500.0
         return params
 
     def runBench(self, params):
@@ -229,11 +230,17 @@ class EradicateCLI:
     def makeGem5CMD(self, p):
 
         ncpu = p.meshRows * p.meshRows
-        cmd = f'{self.cwd}/build/X86_MESI_Two_Level/gem5.{self.opt} \\\n'
+        cmd = f'{self.cwd}/build/X86_{self.protocol}/gem5.{self.opt} \\\n'
         cmd += f'--outdir={p.outdir} \\\n'
         cmd += f'{self.cwd}/configs/example/se.py \\\n'
+        cmd += f'--stats-export="{statsExport}" \\\n'
         cmd += f'--cpu-type=DerivO3CPU \\\n'
-        cmd += f'--num-l2caches={ncpu} \\\n'
+        if self.protocol == 'CHI':
+            # one HNF (LLC slice) per tile; L1/L2 are private
+            cmd += f'--num-l3caches={ncpu} \\\n'
+        else:
+            # one L2 bank per tile (a single cluster for MESI_Three_Level)
+            cmd += f'--num-l2caches={ncpu} \\\n'
         cmd += f'--num-cpus={ncpu} \\\n'
         cmd += f'--num-dirs={ncpu} \\\n'
         cmd += f'--ruby \\\n'
@@ -254,6 +261,16 @@ class EradicateCLI:
         else:
             cmd += f'--options="{p.flushNum} 0 {ncpu-1}" \\\n'
 
+        if p.flushType == 'eradicate-engine':
+            assert self.protocol == 'MESI_Two_Level', \
+                'eradicate-engine is only implemented for MESI_Two_Level'
+            cmd += f'--flush-engine \\\n'
+
+        if p.flushType == 'eradicate-bulk':
+            assert self.protocol != 'CHI', \
+                'eradicate-bulk is not implemented for CHI'
+            cmd += f'--flush-bulk \\\n'
+
         if p.netRoutingType == 'multicast':
             cmd += f'--enable-rpm \\\n'
             cmd += f'--routing-algorithm=2 \\\n'
@@ -262,7 +279,7 @@ class EradicateCLI:
         cmd += f'> {p.outdir}/log 2>&1\n'
 
         p.gem5CMD= cmd
-        p.statFile = f'{p.outdir}/stats.txt'
+        p.statFile = f'{p.outdir}/stats.jsonl'
 
     def generateTable(self, finishedTests, id) -> Table:
         self.lock.acquire()
@@ -351,7 +368,7 @@ class EradicateCLI:
 # Sub commands
 #################################################################
 def buildGEM5(args):
-    cmd = f'scons {os.getcwd()}/build/X86_MESI_Two_Level/gem5.{args.opt} -j16'
+    cmd = f'scons {os.getcwd()}/build/X86_{args.protocol}/gem5.{args.opt} -j16'
     os.system(cmd)
 
 def buildBench(args):
@@ -382,6 +399,12 @@ def main(argv: List[str] = None):
                             type=str, default='debug',
                             help="Build options (debug/opt/fast).")
 
+    parser.add_argument('--protocol', action='store',
+                            type=str, default='MESI_Two_Level',
+                            choices=['MESI_Two_Level', 'MESI_Three_Level',
+                                     'CHI'],
+                            help="Ruby protocol to build and simulate.")
+
     parser.add_argument('--benchmarks', action='store',
                             type=str, nargs='+',
                             choices=['npstate', 'estate', 'mstate', 'sstate'],
@@ -390,7 +413,8 @@ def main(argv: List[str] = None):
 
     parser.add_argument('--flush-type', action='store',
                             type=str, nargs='+',
-                            choices=['clflush', 'eradicate'],
+                            choices=['clflush', 'eradicate',
+                                     'eradicate-engine', 'eradicate-bulk'],
                             default=['clflush', 'eradicate'],
                             help="Method to flush cache lines")
 
@@ -18,9 +18,19 @@ import pandas as pd
 import numpy as np
 import matplotlib.pyplot as plt
 import concurrent.futures
+from cli_stats import readStats
 
 progName='RPM-CLI'
 
+# Spacing of the injection rate grid, shared by the per-rate runs and
+# the single sweep run
+injRateStep = 0.005
+
+#################################################################
+# Stats the gem5 runs export as JSON lines, one record per stat dump
+#################################################################
+statsExport = "jsonl://stats.jsonl?filter='^simTicks|network[.](packets_injected|average_packet_latency|avg_link_utilization)'"
+
 #################################################################
 # Data class for each throughput simulation
 #################################################################
@@ -50,7 +60,17 @@ class RPMCLI:
         self.schemes            = args.schemes
         self.trafficPatterns    = args.traffic_patterns
         self.rpmPacketTypes     = args.rpm_packet_types
-        self.injRates           = [round(x, 3) for x in np.arange(0.005, 1.0, 0.005)]
+        self.setasideDepth      = args.setaside_depth
+        self.setasideArbitration = args.setaside_arbitration
+        self.multicastFraction  = args.multicast_fraction
+        self.broadcastFraction  = args.broadcast_fraction
+        self.multicastDestsMax  = args.multicast_dests_max
+        self.multicastDestsDist = args.multicast_dests_dist
+        self.hotspotFraction    = args.hotspot_fraction
+        self.garnetPartitions   = args.garnet_partitions
+        self.sampled            = args.sampled
+        self.injRates           = [round(x, 3) for x in
+                                   np.arange(injRateStep, 1.0, injRateStep)]
         self.outdirRoot         = f'{args.outdir_root}'
         self.csvFile            = f'{self.outdirRoot}/output.csv'
 
@@ -59,7 +79,7 @@ class RPMCLI:
                                 * len(self.schemes) \
                                 * len(self.trafficPatterns) \
                                 * len(self.rpmPacketTypes) \
-                                * len(self.injRates)
+                                * (1 if self.sampled else len(self.injRates))
         self.lock               = threading.Lock()
 
     def simThroughput(self):
@@ -101,6 +121,9 @@ class RPMCLI:
 
         if reloadStats:
             for params in self.forEachTest():
+                if self.sampled:
+                    self.readSweep(params)
+                    continue
                 print(f'Processing {params.statFile} ...')
                 params = self.getStats(params)
                 if params.latency != -1:
@@ -241,27 +264,13 @@ class RPMCLI:
         ax.set_ylabel(ylabel) #fontdict={'fontsize':9}
 
     def getStats(self, params):
-        simCycles = 0
-        totalInjectedPacket = 0
         totalNodes = params.meshRows * params.meshRows
-        with open(params.statFile, "r") as f:
-            for line in f:
-                if 'simTicks' in line:
-                    line = " ".join(line.strip().split())
-                    simCycles = float(line.split(' ')[1]) / 500.0
-
-                if 'packets_injected::total' in line:
-                    line = " ".join(line.strip().split())
-                    params.totalInjectedPacket = float(line.split(' ')[1])
-
-                if 'average_packet_latency' in line:
-                    line = " ".join(line.strip().split())
-                    params.latency = float(line.split(' ')[1]) / 500.0
-
-                if 'avg_link_utilization' in line:
-                    line = " ".join(line.strip().split())
-                    params.avgLinkUtil = float(line.split(' ')[1])
-       
+        stats = readStats(params.statFile)
+        simCycles = (stats.get('simTicks') or 0) / 500.0
+        params.totalInjectedPacket = stats.get('packets_injected::total') or 0
+        params.latency = (stats.get('average_packet_latency') or -500.0) / 500.0
+        params.avgLinkUtil = stats.get('avg_link_utilization', -1)
+
         if params.latency > 0 and params.totalInjectedPacket != 0 \
             and totalNodes != 0 and simCycles != 0:
             params.effInjRate = params.totalInjectedPacket/totalNodes/simCycles
@@ -282,6 +291,10 @@ class RPMCLI:
         params.status = '[cyan]READING STATS'
         self.updateDataframe(params)
 
+        if self.sampled:
+            self.readSweep(params)
+            return
+
         params = self.getStats(params)
         if params.latency > 0:
             params.status = '[green]SUCCESS'
@@ -289,14 +302,42 @@ class RPMCLI:
             params.status = '[red]FAILED'
         self.updateDataframe(params)
 
+    # One row per injection rate from the sweep.csv of a sampled run.
+    # Rates past saturation were not simulated and get no latency.
+    def readSweep(self, params):
+        sweepFile = f'{params.outdir}/sweep.csv'
+        sweep = pd.read_csv(sweepFile) if os.path.exists(sweepFile) \
+            else pd.DataFrame(columns=['injection_rate'], dtype=float)
+        for injRate in self.injRates:
+            p = Params(
+                meshRows=params.meshRows,
+                scheme=params.scheme,
+                trafficPattern=params.trafficPattern,
+                rpmPacketType=params.rpmPacketType,
+                injRate=injRate,
+                outdir=params.outdir,
+                latency=float('nan'),
+                status='[green]SUCCESS (saturated)')
+            row = sweep.loc[np.isclose(sweep['injection_rate'], injRate)]
+            if len(row) == 1:
+                p.latency = row['latency'].values[0]
+                p.effInjRate = row['effective_injection_rate'].values[0]
+                p.totalInjectedPacket = row['injected_packets'].values[0]
+                p.status = '[green]SUCCESS'
+            self.updateDataframe(p)
+
+        params.status = '[green]SUCCESS' if len(sweep) > 0 else '[red]FAILED'
+        self.updateDataframe(params)
+
     def forEachTest(self):
         for meshRows in self.meshRowsList:
             for scheme in self.schemes:
                 for trafficPattern in self.trafficPatterns:
                     for rpmPacketType in self.rpmPacketTypes:
-                        for injRate in self.injRates:
+                        for injRate in ([-1] if self.sampled else self.injRates):
                             outdir = f'{self.outdirRoot}/{meshRows}x{meshRows}/{scheme}/'
-                            outdir+=f'{rpmPacketType}/{trafficPattern}/{injRate}'
+                            outdir+=f'{rpmPacketType}/{trafficPattern}/'
+                            outdir+='sweep' if self.sampled else f'{injRate}'
                             p =  Params(
                                 meshRows=meshRows,
                                 scheme=scheme,
@@ -312,6 +353,7 @@ class RPMCLI:
         cmd = f'{self.cwd}/build/NULL/gem5.{self.opt} \\\n'
         cmd += f'--outdir={p.outdir} \\\n'
         cmd += f'{self.cwd}/configs/example/garnet_synth_traffic.py \\\n'
+        cmd += f'--stats-export="{statsExport}" \\\n'
         cmd += f'--num-cpus={p.meshRows*p.meshRows} \\\n'
         cmd += f'--num-dirs={p.meshRows*p.meshRows} \\\n'
         cmd += f'--network=garnet \\\n'
@@ -325,22 +367,37 @@ class RPMCLI:
         cmd += f'--synthetic={p.trafficPattern} \\\n'
         cmd += f'--sim-cycles=1000000 \\\n'
         #cmd += f'--num-packets-max=50000000 \\\n'
-        cmd += f'--injectionrate={p.injRate} \\\n'
+        if self.sampled:
+            rates = f'{self.injRates[0]}:{self.injRates[-1]}:{injRateStep}'
+            cmd += f'--sweep-rates={rates} \\\n'
+        else:
+            cmd += f'--injectionrate={p.injRate} \\\n'
         cmd += f'--num-packets-max=-1 \\\n'
         cmd += f'--single-sender-id=-1 \\\n'
         cmd += f'--single-dest-id=-1 \\\n'
         cmd += f'--inj-vnet=2 \\\n'
         cmd += f'--rpm-packet-type={p.rpmPacketType} \\\n'
+        if self.garnetPartitions > 1:
+            cmd += f'--garnet-partitions={self.garnetPartitions} \\\n'
+        if p.rpmPacketType == 3:
+            cmd += f'--multicast-fraction={self.multicastFraction} \\\n'
+            cmd += f'--broadcast-fraction={self.broadcastFraction} \\\n'
+            cmd += f'--multicast-dests-max={self.multicastDestsMax} \\\n'
+            cmd += f'--multicast-dests-dist={self.multicastDestsDist} \\\n'
+            cmd += f'--hotspot-fraction={self.hotspotFraction} \\\n'
 
         if p.scheme == 'base':
             cmd += f'--routing-algorithm=1 \\\n'
         else:
             cmd += f'--routing-algorithm=2 \\\n'
             cmd += f'--enable-rpm \\\n'
+            cmd += f'--rpm-setaside-depth={self.setasideDepth} \\\n'
+            cmd += f'--rpm-setaside-arbitration={self.setasideArbitration} \\\n'
+            cmd += f'--multicast-routing={p.scheme} \\\n'
         cmd += f'> {p.outdir}/log 2>&1\n'
 
         p.gem5CMD= cmd
-        p.statFile = f'{p.outdir}/stats.txt'
+        p.statFile = f'{p.outdir}/stats.jsonl'
 
     def generateTable(self, finishedTests) -> Table:
         self.lock.acquire()
@@ -466,9 +523,12 @@ def main(argv: List[str] = None):
                             help="Build options (debug/opt/fast).")
     parser.add_argument('--schemes', action='store',
                             type=str, nargs='+',
-                            choices=['base', 'rpm'],
+                            choices=['base', 'rpm', 'xy_tree', 'dual_path',
+                                     'unicast'],
                             default=['base', 'rpm'],
-                            help="List of schems.")
+                            help="List of schems. Every scheme but base "
+                                 "runs on the RPM network with its own "
+                                 "multicast routing.")
     parser.add_argument('--traffic-patterns', action='store',
                             type=str, nargs='+',
                             choices=[
@@ -497,7 +557,39 @@ def main(argv: List[str] = None):
                             type=int, nargs='+', default=[0,1,2],
                             help="""types of rpm packetself.
                             1: multicast packet.
-                            2: broadcast packet. Every packet is broadcast.""")
+                            2: broadcast packet. Every packet is broadcast.
+                            3: mix of unicast, multicast and broadcast set
+                               by the --multicast-*, --broadcast-fraction
+                               and --hotspot-fraction options.""")
+    parser.add_argument('--multicast-fraction', action='store',
+                            type=float, default=0.2,
+                            help="Share of multicast packets for type 3.")
+    parser.add_argument('--broadcast-fraction', action='store',
+                            type=float, default=0.0,
+                            help="Share of broadcast packets for type 3.")
+    parser.add_argument('--multicast-dests-max', action='store',
+                            type=int, default=16,
+                            help="Largest multicast destination set for type 3.")
+    parser.add_argument('--multicast-dests-dist', action='store',
+                            type=str, choices=['uniform', 'geometric'],
+                            default='uniform',
+                            help="Multicast destination set size distribution for type 3.")
+    parser.add_argument('--hotspot-fraction', action='store',
+                            type=float, default=0.0,
+                            help="Share of packets sent to node 0 for type 3.")
+    parser.add_argument('--setaside-depth', action='store',
+                            type=int, default=16,
+                            help="Replicas each RPM set-aside buffer can hold.")
+    parser.add_argument('--setaside-arbitration', action='store',
+                            type=str, choices=['round_robin', 'age'],
+                            default='round_robin',
+                            help="How set-aside replicas compete with input VCs.")
+    parser.add_argument('--garnet-partitions', action='store',
+                            type=int, default=1,
+                            help="Mesh tiles simulated on separate threads.")
+    parser.add_argument('--sampled', action='store_true',
+                            help="Sweep all injection rates in one gem5 run "
+                            "per curve, stopping at saturation.")
     parser.add_argument('--outdir-root',
                             type=str, default='./m5out', help="",)
     parser.add_argument('--max-workers',
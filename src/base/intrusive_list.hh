@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_INTRUSIVE_LIST_HH__
+#define __BASE_INTRUSIVE_LIST_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "base/refcnt.hh"
+
+/**
+ * @file base/intrusive_list.hh
+ *
+ * A list of reference counted objects linked through hooks in the
+ * objects themselves.
+ */
+
+namespace gem5
+{
+
+/**
+ * The links of an object on one IntrusiveList. The hook also holds the
+ * reference the list keeps on the object, so the object lives at least
+ * as long as it is on the list.
+ */
+template <class T>
+struct IntrusiveListHook
+{
+    T *prev = nullptr;
+    T *next = nullptr;
+    RefCountingPtr<T> ref;
+
+    bool linked() const { return ref; }
+};
+
+/**
+ * The HookOf parameter of an IntrusiveList for a hook member of a class.
+ * Lists that must be declared while T is incomplete name a class with
+ * the same static hook() function instead, defined once T is complete.
+ */
+template <class T, IntrusiveListHook<T> T::*Member>
+struct IntrusiveListMember
+{
+    static IntrusiveListHook<T> &hook(T *obj) { return obj->*Member; }
+};
+
+/**
+ * A doubly linked list of RefCountingPtr<T> that keeps its links in a
+ * hook of T, found by HookOf::hook(), instead of separately allocated
+ * nodes, so adding and removing objects never allocates. An object can
+ * be on as many lists at once as it has hooks, but only on one list per
+ * hook.
+ *
+ * Iterators behave like std::list iterators: they stay valid until
+ * their own object is erased, and end() can be decremented to the last
+ * object.
+ */
+template <class T, class HookOf>
+class IntrusiveList
+{
+  private:
+    T *head = nullptr;
+    T *tail = nullptr;
+    size_t _size = 0;
+
+    static IntrusiveListHook<T> &hook(T *obj) { return HookOf::hook(obj); }
+
+  public:
+    class iterator
+    {
+      private:
+        friend class IntrusiveList;
+
+        const IntrusiveList *list = nullptr;
+        T *node = nullptr;
+
+        iterator(const IntrusiveList *_list, T *_node)
+            : list(_list), node(_node)
+        {}
+
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef RefCountingPtr<T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const RefCountingPtr<T> *pointer;
+        typedef const RefCountingPtr<T> &reference;
+
+        iterator() = default;
+
+        reference operator*() const { return hook(node).ref; }
+        pointer operator->() const { return &hook(node).ref; }
+
+        iterator &
+        operator++()
+        {
+            node = hook(node).next;
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        iterator &
+        operator--()
+        {
+            node = node ? hook(node).prev : list->tail;
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        bool
+        operator==(const iterator &other) const
+        {
+            return list == other.list && node == other.node;
+        }
+
+        bool operator!=(const iterator &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    IntrusiveList() = default;
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    ~IntrusiveList() { clear(); }
+
+    iterator begin() const { return iterator(this, head); }
+    iterator end() const { return iterator(this, nullptr); }
+
+    /** The iterator of an object on this list. */
+    iterator
+    iteratorTo(T *obj) const
+    {
+        assert(hook(obj).linked());
+        return iterator(this, obj);
+    }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    const RefCountingPtr<T> &front() const { return hook(head).ref; }
+    const RefCountingPtr<T> &back() const { return hook(tail).ref; }
+
+    /** Link obj in front of pos. */
+    iterator
+    insert(iterator pos, const RefCountingPtr<T> &obj)
+    {
+        auto &h = hook(obj.get());
+        assert(!h.linked());
+        assert(pos.list == this);
+
+        T *next = pos.node;
+        T *prev = next ? hook(next).prev : tail;
+        h.prev = prev;
+        h.next = next;
+        h.ref = obj;
+        (prev ? hook(prev).next : head) = obj.get();
+        (next ? hook(next).prev : tail) = obj.get();
+        _size++;
+
+        return iterator(this, obj.get());
+    }
+
+    void push_back(const RefCountingPtr<T> &obj) { insert(end(), obj); }
+    void push_front(const RefCountingPtr<T> &obj) { insert(begin(), obj); }
+
+    /**
+     * Unlink the object at pos and return the iterator of the next one.
+     * The object is released if the list held the last reference.
+     */
+    iterator
+    erase(iterator pos)
+    {
+        assert(pos.list == this && pos.node);
+        auto &h = hook(pos.node);
+        T *prev = h.prev;
+        T *next = h.next;
+
+        (prev ? hook(prev).next : head) = next;
+        (next ? hook(next).prev : tail) = prev;
+        h.prev = nullptr;
+        h.next = nullptr;
+        _size--;
+
+        // drop the reference last, it may delete the object
+        RefCountingPtr<T> ref = std::move(h.ref);
+        return iterator(this, next);
+    }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(this, tail)); }
+
+    void
+    clear()
+    {
+        while (!empty())
+            pop_back();
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_INTRUSIVE_LIST_HH__
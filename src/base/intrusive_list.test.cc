@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/intrusive_list.hh"
+#include "base/refcnt.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class Obj : public RefCounted
+{
+  public:
+    Obj(int _value, int &_live) : value(_value), live(_live) { live++; }
+    ~Obj() { live--; }
+
+    int value;
+    int &live;
+
+    IntrusiveListHook<Obj> aHook;
+    IntrusiveListHook<Obj> bHook;
+};
+
+typedef RefCountingPtr<Obj> ObjPtr;
+typedef IntrusiveList<Obj, IntrusiveListMember<Obj, &Obj::aHook>> AList;
+typedef IntrusiveList<Obj, IntrusiveListMember<Obj, &Obj::bHook>> BList;
+
+std::vector<int>
+values(const AList &list)
+{
+    std::vector<int> v;
+    for (auto it = list.begin(); it != list.end(); ++it)
+        v.push_back((*it)->value);
+    return v;
+}
+
+} // anonymous namespace
+
+TEST(IntrusiveListTest, PushAndPop)
+{
+    int live = 0;
+    AList list;
+    ASSERT_TRUE(list.empty());
+
+    list.push_back(new Obj(1, live));
+    list.push_back(new Obj(2, live));
+    list.push_front(new Obj(0, live));
+
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(values(list), std::vector<int>({0, 1, 2}));
+    ASSERT_EQ(list.front()->value, 0);
+    ASSERT_EQ(list.back()->value, 2);
+
+    list.pop_front();
+    list.pop_back();
+    ASSERT_EQ(values(list), std::vector<int>({1}));
+    ASSERT_EQ(live, 1);
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(live, 0);
+}
+
+TEST(IntrusiveListTest, HoldsReference)
+{
+    int live = 0;
+    AList list;
+    {
+        ObjPtr obj = new Obj(1, live);
+        list.push_back(obj);
+    }
+    // the list keeps the object alive
+    ASSERT_EQ(live, 1);
+
+    ObjPtr obj = list.front();
+    list.pop_front();
+    ASSERT_EQ(live, 1);
+    ASSERT_FALSE(obj->aHook.linked());
+
+    obj = nullptr;
+    ASSERT_EQ(live, 0);
+}
+
+TEST(IntrusiveListTest, Iterators)
+{
+    int live = 0;
+    AList list;
+    for (int i = 0; i < 5; i++)
+        list.push_back(new Obj(i, live));
+
+    // walk back from end() like the squash loops do
+    auto it = list.end();
+    --it;
+    ASSERT_EQ((*it)->value, 4);
+    it--;
+    ASSERT_EQ((*it)->value, 3);
+
+    // erasing an object leaves the other iterators valid
+    auto first = list.begin();
+    it = list.erase(it);
+    ASSERT_EQ((*it)->value, 4);
+    ASSERT_EQ((*first)->value, 0);
+    ASSERT_EQ(live, 4);
+
+    // erase(it--) erases an object and steps to the one before it
+    it = list.end();
+    --it;
+    list.erase(it--);
+    ASSERT_EQ((*it)->value, 2);
+
+    it = list.insert(it, new Obj(7, live));
+    ASSERT_EQ(values(list), std::vector<int>({0, 1, 7, 2}));
+    ASSERT_EQ(list.iteratorTo(it->get()), it);
+
+    // end iterators of different lists differ
+    AList other;
+    ASSERT_NE(list.end(), other.end());
+}
+
+TEST(IntrusiveListTest, SeveralHooks)
+{
+    int live = 0;
+    AList a;
+    BList b;
+
+    ObjPtr x = new Obj(1, live);
+    ObjPtr y = new Obj(2, live);
+    a.push_back(x);
+    a.push_back(y);
+    b.push_back(y);
+    b.push_back(x);
+
+    x = nullptr;
+    y = nullptr;
+    ASSERT_EQ(values(a), std::vector<int>({1, 2}));
+    ASSERT_EQ(b.front()->value, 2);
+
+    a.clear();
+    ASSERT_EQ(live, 2);
+    b.pop_front();
+    ASSERT_EQ(live, 1);
+    b.clear();
+    ASSERT_EQ(live, 0);
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+Columnar::Columnar(std::ostream &_stream, Format _format,
+                   const std::string &_filter)
+    : stream(&_stream), format(_format), filter(_filter)
+{
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+
+    *stream << std::setprecision(15);
+}
+
+bool
+Columnar::valid() const
+{
+    return stream != NULL && stream->good();
+}
+
+void
+Columnar::begin()
+{
+    record.clear();
+    record.emplace_back("tick", (Result)curTick());
+}
+
+void
+Columnar::end()
+{
+    if (format == CSV)
+        writeCSV();
+    else
+        writeJSONLines();
+    stream->flush();
+}
+
+std::string
+Columnar::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return csprintf("%s.%s", path.top(), name);
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(csprintf("%s.%s", path.top(), name));
+    }
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Columnar::noOutput(const Info &info, const std::string &name) const
+{
+    // Prerequisites and nozero are ignored on purpose so that every
+    // dump produces the same set of columns.
+    if (!info.flags.isSet(display))
+        return true;
+
+    return !std::regex_search(name, filter);
+}
+
+void
+Columnar::add(const std::string &name, Result value)
+{
+    record.emplace_back(name, value);
+}
+
+void
+Columnar::addVector(const std::string &name, const std::string &separator,
+                    const std::vector<std::string> &subnames,
+                    const VResult &values, Result total)
+{
+    for (off_type i = 0; i < values.size(); ++i) {
+        if (i < subnames.size() && !subnames[i].empty())
+            add(name + separator + subnames[i], values[i]);
+        else
+            add(csprintf("%s%s%d", name, separator, i), values[i]);
+    }
+    add(name + separator + "total", total);
+}
+
+void
+Columnar::addDist(const std::string &name, const DistData &data)
+{
+    add(name + "::samples", data.samples);
+    add(name + "::mean", data.samples ? data.sum / data.samples : NAN);
+}
+
+void
+Columnar::writeValue(Result value)
+{
+    if (std::isnan(value) || std::isinf(value)) {
+        if (format == JSONLines)
+            *stream << "null";
+    } else {
+        *stream << value;
+    }
+}
+
+void
+Columnar::writeCSV()
+{
+    if (columns.empty()) {
+        for (const auto &entry : record)
+            columns.push_back(entry.first);
+
+        for (off_type i = 0; i < columns.size(); ++i)
+            *stream << (i ? "," : "") << columns[i];
+        *stream << "\n";
+    }
+
+    // Stats that were not part of the first dump are dropped, and
+    // columns without a value in this dump are left empty.
+    std::unordered_map<std::string, Result> values(record.begin(),
+                                                   record.end());
+    for (off_type i = 0; i < columns.size(); ++i) {
+        if (i)
+            *stream << ",";
+        auto it = values.find(columns[i]);
+        if (it != values.end())
+            writeValue(it->second);
+    }
+    *stream << "\n";
+}
+
+void
+Columnar::writeJSONLines()
+{
+    *stream << "{";
+    for (off_type i = 0; i < record.size(); ++i) {
+        *stream << (i ? ", \"" : "\"");
+        for (char c : record[i].first) {
+            if (c == '"' || c == '\\')
+                *stream << '\\';
+            *stream << c;
+        }
+        *stream << "\": ";
+        writeValue(record[i].second);
+    }
+    *stream << "}\n";
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    add(name, info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    addVector(name, info.separatorString, info.subnames, info.result(),
+              info.total());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    addDist(name, info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    for (off_type i = 0; i < info.size(); ++i) {
+        if (i < info.subnames.size() && !info.subnames[i].empty())
+            addDist(name + info.separatorString + info.subnames[i],
+                    info.data[i]);
+        else
+            addDist(csprintf("%s%s%d", name, info.separatorString, i),
+                    info.data[i]);
+    }
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    add(name + info.separatorString + "total", info.total());
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    // Scalar formulas such as average_packet_latency keep their name.
+    const VResult &values = info.result();
+    if (values.size() == 1 && info.subnames.empty())
+        add(name, values[0]);
+    else
+        addVector(name, info.separatorString, info.subnames, values,
+                  info.total());
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    const std::string name = statName(info.name);
+    if (noOutput(info, name))
+        return;
+
+    add(name + info.separatorString + "samples", info.data.samples);
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, const std::string &format,
+             const std::string &filter)
+{
+    Columnar::Format fmt;
+    if (format == "csv")
+        fmt = Columnar::CSV;
+    else if (format == "jsonl")
+        fmt = Columnar::JSONLines;
+    else
+        fatal("Unknown columnar stat format '%s'\n", format);
+
+    return std::unique_ptr<Output>(new Columnar(
+        *simout.findOrCreate(filename)->stream(), fmt, filter));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <iosfwd>
+#include <memory>
+#include <regex>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+/**
+ * Machine-readable stat output that writes one record per stat dump,
+ * meant for scripts that sweep many simulations and only need a
+ * handful of numbers from each.
+ *
+ * Only stats whose full name matches the filter regex are written.
+ * Vectors and formulas are flattened into name::subname and
+ * name::total entries, distributions into name::samples and
+ * name::mean, and 2d vectors into name::total. Every record starts
+ * with the current tick.
+ *
+ * In CSV format the columns are fixed by the first dump, which also
+ * writes the header line. In JSON lines format each dump is a single
+ * JSON object mapping stat names to values, with NaN written as null.
+ */
+class Columnar : public Output
+{
+  public:
+    enum Format
+    {
+        CSV,
+        JSONLines,
+    };
+
+  protected:
+    std::ostream *stream;
+    Format format;
+    std::regex filter;
+
+    // Object/group path
+    std::stack<std::string> path;
+
+    // Values collected during the current dump
+    std::vector<std::pair<std::string, Result>> record;
+
+    // CSV column names, set by the first dump
+    std::vector<std::string> columns;
+
+  protected:
+    std::string statName(const std::string &name) const;
+    bool noOutput(const Info &info, const std::string &name) const;
+    void add(const std::string &name, Result value);
+    void addVector(const std::string &name, const std::string &separator,
+                   const std::vector<std::string> &subnames,
+                   const VResult &values, Result total);
+    void addDist(const std::string &name, const DistData &data);
+
+    void writeValue(Result value);
+    void writeCSV();
+    void writeJSONLines();
+
+  public:
+    Columnar(std::ostream &stream, Format format, const std::string &filter);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     const std::string &format,
+                                     const std::string &filter);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -136,6 +136,7 @@ BaseCPU::BaseCPU(const Params &p, bool is_checker)
       currentFunctionEnd(0), functionEntryTick(0),
       baseStats(this),
       addressMonitor(p.numThreads),
+      numFlush(p.numThreads, 1),
       syscallRetryLatency(p.syscallRetryLatency),
       pwrGatingLatency(p.pwr_gating_latency),
       powerGatingOnIdle(p.power_gating_on_idle),
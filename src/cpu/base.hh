@@ -53,7 +53,6 @@
 #else
 #include "arch/generic/interrupts.hh"
 #include "base/statistics.hh"
-#include "cpu/global_fnum.hh"
 #include "debug/Mwait.hh"
 #include "mem/htm.hh"
 #include "mem/port_proxy.hh"
@@ -171,10 +170,6 @@ class BaseCPU : public ClockedObject
 
   public:
 
-    void set_fnum(const uint64_t fnum) {
-      global_fnum = fnum;
-    }
-
     /**
      * Purely virtual method that returns a reference to the data
      * port. All subclasses must implement this method.
@@ -616,7 +611,27 @@ class BaseCPU : public ClockedObject
   private:
     std::vector<AddressMonitor> addressMonitor;
 
+    /**
+     * Per-thread number of cache lines covered by the next CLFLUSH,
+     * as set by m5_set_numflush.
+     */
+    std::vector<uint64_t> numFlush;
+
   public:
+    void
+    setNumFlush(ThreadID tid, uint64_t num)
+    {
+        assert(tid < numThreads);
+        numFlush[tid] = num;
+    }
+
+    uint64_t
+    getNumFlush(ThreadID tid) const
+    {
+        assert(tid < numThreads);
+        return numFlush[tid];
+    }
+
     void armMonitor(ThreadID tid, Addr address);
     bool mwait(ThreadID tid, PacketPtr pkt);
     void mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu);
@@ -1,7 +0,0 @@
-#include "global_fnum.hh"
-
-namespace gem5
-{
-    uint64_t global_fnum = 0;
-}
-
@@ -1,10 +0,0 @@
-#ifndef __CPU_GLOBAL_FNUM_HH__
-#define __CPU_GLOBAL_FNUM_HH__
-
-#include <stdint.h>
-
-namespace gem5
-{
-    extern uint64_t global_fnum;
-}
-#endif
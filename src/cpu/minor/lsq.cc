@@ -1650,6 +1650,7 @@ LSQ::pushRequest(MinorDynInstPtr inst, bool isLoad, uint8_t *data,
         /* I've no idea why we need the PC, but give it */
         inst->pc->instAddr(), std::move(amo_op));
     request->request->setByteEnable(byte_enable);
+    request->request->setNumFlush(cpu.getNumFlush(inst->id.threadId));
 
     requests.push(request);
     inst->inLSQ = true;
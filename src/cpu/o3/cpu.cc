@@ -80,6 +80,7 @@ CPU::CPU(const O3CPUParams &params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      dynInstPool(new DynInstPool),
       removeInstsThisCycle(false),
       fetch(this, params),
       decode(this, params),
@@ -340,6 +341,13 @@ CPU::CPU(const O3CPUParams &params)
     }
 }
 
+CPU::~CPU()
+{
+    // Instructions can outlive the CPU, e.g. in packets still in the
+    // memory system, the pool goes once the last one is released.
+    dynInstPool->detach();
+}
+
 void
 CPU::regProbePoints()
 {
@@ -1326,12 +1334,10 @@ CPU::squashFromTC(ThreadID tid)
     commit.generateTCEvent(tid);
 }
 
-CPU::ListIt
+void
 CPU::addInst(const DynInstPtr &inst)
 {
     instList.push_back(inst);
-
-    return --(instList.end());
 }
 
 void
@@ -1363,7 +1369,7 @@ CPU::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push(instList.iteratorTo(inst.get()));
 }
 
 void
@@ -1383,7 +1389,7 @@ CPU::removeInstsNotInROB(ThreadID tid)
         end_it = instList.begin();
         rob_empty = true;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_it = instList.iteratorTo(rob.readTailInst(tid).get());
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
@@ -55,6 +55,7 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
@@ -94,7 +95,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef DynInstList<InCPUList>::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -171,6 +172,8 @@ class CPU : public BaseCPU
     /** Constructs a CPU with the given parameters. */
     CPU(const O3CPUParams &params);
 
+    ~CPU();
+
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
 
@@ -399,7 +402,7 @@ class CPU : public BaseCPU
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
      */
-    ListIt addInst(const DynInstPtr &inst);
+    void addInst(const DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, const DynInstPtr &inst);
@@ -431,8 +434,13 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
+    /** Storage for the instructions in flight and their register
+     *  index arrays.
+     */
+    DynInstPool *dynInstPool;
+
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    DynInstList<InCPUList> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -41,6 +41,7 @@
 #include "cpu/o3/dyn_inst.hh"
 
 #include <algorithm>
+#include <cstddef>
 
 #include "base/intmath.hh"
 #include "debug/DynInst.hh"
@@ -167,8 +168,10 @@ DynInst::operator new(size_t count, Arrays &arrays)
     // Figure out how much space we need in total.
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
-    // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    // Actually allocate it, from the CPU's pool if it has one.
+    static_assert(alignof(DynInst) <= alignof(std::max_align_t),
+                  "DynInstPool blocks are not aligned for DynInst");
+    uint8_t *buf = (uint8_t *)DynInstPool::allocate(arrays.pool, total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,6 +190,18 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
+void
+DynInst::operator delete(void *ptr)
+{
+    DynInstPool::release(ptr);
+}
+
+void
+DynInst::operator delete(void *ptr, Arrays &arrays)
+{
+    DynInstPool::release(ptr);
+}
+
 DynInst::~DynInst()
 {
     /*
@@ -57,6 +57,7 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
@@ -80,14 +81,14 @@ class DynInst : public ExecContext, public RefCounted
             InstSeqNum seq_num, CPU *cpu);
 
   public:
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     struct Arrays
     {
         size_t numSrcs;
         size_t numDests;
 
+        /** Where to allocate the instruction, the heap if null. */
+        DynInstPool *pool = nullptr;
+
         RegId *flatDestIdx;
         PhysRegIdPtr *destIdx;
         PhysRegIdPtr *prevDestIdx;
@@ -96,6 +97,8 @@ class DynInst : public ExecContext, public RefCounted
     };
 
     static void *operator new(size_t count, Arrays &arrays);
+    static void operator delete(void *ptr);
+    static void operator delete(void *ptr, Arrays &arrays);
 
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const Arrays &arrays, const StaticInstPtr &staticInst,
@@ -316,8 +319,11 @@ class DynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber = 0;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
+    /** Links of this instruction in the CPU's list of all insts. */
+    IntrusiveListHook<DynInst> cpuListHook;
+
+    /** Links of this instruction in the memory dependence unit. */
+    IntrusiveListHook<DynInst> memDepListHook;
 
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
@@ -944,12 +950,6 @@ class DynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
-
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
-
   public:
     /** Returns the number of consecutive store conditional failures. */
     unsigned int
@@ -1239,6 +1239,18 @@ class DynInst : public ExecContext, public RefCounted
     }
 };
 
+inline IntrusiveListHook<DynInst> &
+InCPUList::hook(DynInst *inst)
+{
+    return inst->cpuListHook;
+}
+
+inline IntrusiveListHook<DynInst> &
+InMemDepUnit::hook(DynInst *inst)
+{
+    return inst->memDepListHook;
+}
+
 } // namespace o3
 } // namespace gem5
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <cassert>
+#include <new>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::~DynInstPool()
+{
+    for (auto slab : slabs)
+        ::operator delete(slab);
+}
+
+void *
+DynInstPool::allocate(DynInstPool *pool, size_t size)
+{
+    if (pool)
+        return pool->allocateBlock(size);
+
+    Header *header = (Header *)::operator new(sizeof(Header) + size);
+    header->pool = nullptr;
+    return header + 1;
+}
+
+void
+DynInstPool::release(void *ptr)
+{
+    Header *header = (Header *)ptr - 1;
+    if (header->pool)
+        header->pool->releaseBlock(header);
+    else
+        ::operator delete(header);
+}
+
+void
+DynInstPool::detach()
+{
+    detached = true;
+    if (_outstanding == 0)
+        delete this;
+}
+
+void *
+DynInstPool::allocateBlock(size_t size)
+{
+    size_t size_class = (sizeof(Header) + size + Granule - 1) / Granule;
+    if (freeLists.size() <= size_class)
+        freeLists.resize(size_class + 1, nullptr);
+
+    FreeBlock *&free_list = freeLists[size_class];
+    if (!free_list) {
+        // carve a new slab into blocks of this size
+        size_t block_size = size_class * Granule;
+        uint8_t *slab =
+            (uint8_t *)::operator new(block_size * BlocksPerSlab);
+        slabs.push_back(slab);
+        for (int i = BlocksPerSlab - 1; i >= 0; i--) {
+            FreeBlock *block = (FreeBlock *)(slab + i * block_size);
+            block->next = free_list;
+            free_list = block;
+        }
+    }
+
+    FreeBlock *block = free_list;
+    free_list = block->next;
+
+    Header *header = (Header *)block;
+    header->pool = this;
+    header->sizeClass = size_class;
+    _outstanding++;
+    return header + 1;
+}
+
+void
+DynInstPool::releaseBlock(Header *header)
+{
+    assert(header->pool == this && _outstanding > 0);
+
+    // the free list link overwrites the header
+    uint32_t size_class = header->sizeClass;
+    FreeBlock *block = (FreeBlock *)header;
+    block->next = freeLists[size_class];
+    freeLists[size_class] = block;
+
+    if (--_outstanding == 0 && detached)
+        delete this;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Storage for the DynInsts of one CPU, together with the register index
+ * arrays allocated behind each of them. Blocks are carved out of slabs
+ * and recycled through free lists per size, so once the pool has grown
+ * to the instructions in flight, fetching and squashing instructions no
+ * longer goes to the heap.
+ *
+ * Every block starts with a header naming its pool, which lets a block
+ * be released without knowing where it came from. The pool is only used
+ * by the thread of its CPU, it takes no locks.
+ */
+class DynInstPool
+{
+  public:
+    DynInstPool() = default;
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    /**
+     * Allocate size bytes from the pool, or from the heap if pool is
+     * null. The memory is aligned for any fundamental type.
+     */
+    static void *allocate(DynInstPool *pool, size_t size);
+
+    /** Release memory obtained from allocate(). */
+    static void release(void *ptr);
+
+    /**
+     * The owner of the pool is going away. The pool frees itself once
+     * the blocks still in use have been released.
+     */
+    void detach();
+
+    /** Blocks handed out and not released yet. */
+    uint64_t outstanding() const { return _outstanding; }
+
+  private:
+    ~DynInstPool();
+
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        DynInstPool *pool;
+        uint32_t sizeClass;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    //! Block sizes are multiples of the granule, a slab holds
+    //! BlocksPerSlab blocks of one size.
+    static constexpr size_t Granule = 64;
+    static constexpr int BlocksPerSlab = 32;
+
+    void *allocateBlock(size_t size);
+    void releaseBlock(Header *header);
+
+    std::vector<FreeBlock *> freeLists;
+    std::vector<void *> slabs;
+    uint64_t _outstanding = 0;
+    bool detached = false;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
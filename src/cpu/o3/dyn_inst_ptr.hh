@@ -42,6 +42,7 @@
 #ifndef __CPU_O3_DYN_INST_PTR_HH__
 #define __CPU_O3_DYN_INST_PTR_HH__
 
+#include "base/intrusive_list.hh"
 #include "base/refcnt.hh"
 
 namespace gem5
@@ -55,6 +56,24 @@ class DynInst;
 using DynInstPtr = RefCountingPtr<DynInst>;
 using DynInstConstPtr = RefCountingPtr<const DynInst>;
 
+/**
+ * The in-order lists an instruction is on, each linked through its own
+ * hook in the DynInst. The hooks are found through these classes since
+ * the lists are declared before DynInst is complete.
+ */
+struct InCPUList
+{
+    static IntrusiveListHook<DynInst> &hook(DynInst *inst);
+};
+
+struct InMemDepUnit
+{
+    static IntrusiveListHook<DynInst> &hook(DynInst *inst);
+};
+
+template <class HookOf>
+using DynInstList = IntrusiveList<DynInst, HookOf>;
+
 } // namespace o3
 } // namespace gem5
 
@@ -1517,7 +1517,7 @@ IEW::tick()
                 fromCommit->commitInfo[tid].strictlyOrderedLoad->setAtCommit();
             } else {
                 instQueue.scheduleNonSpec(
-                    fromCommit->commitInfo[tid].nonSpecSeqNum);
+                    fromCommit->commitInfo[tid].nonSpecSeqNum, tid);
             }
         }
 
@@ -41,6 +41,7 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -63,6 +64,30 @@ namespace gem5
 namespace o3
 {
 
+namespace
+{
+
+/** Doubles the ring of one thread, keeping its entries in order. The
+ *  rings cannot be assigned, so all threads' rings are rebuilt.
+ */
+template <class T>
+void
+growRing(std::vector<CircularQueue<T>> &rings, ThreadID tid)
+{
+    std::vector<CircularQueue<T>> grown;
+    grown.reserve(rings.size());
+    for (ThreadID t = 0; t < (ThreadID)rings.size(); t++) {
+        size_t capacity = rings[t].capacity();
+        grown.emplace_back(t == tid ? 2 * capacity : capacity);
+        for (auto &entry : rings[t])
+            grown.back().push_back(std::move(entry));
+        assert(grown.back().size() == rings[t].size());
+    }
+    rings.swap(grown);
+}
+
+} // anonymous namespace
+
 InstructionQueue::FUCompletion::FUCompletion(const DynInstPtr &_inst,
     int fu_idx, InstructionQueue *iq_ptr)
     : Event(Stat_Event_Pri, AutoDelete),
@@ -120,6 +145,18 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
         memDepUnit[tid].setIQ(this);
     }
 
+    // Instructions leave the IQ's list when IEW hears about their commit,
+    // which trails the ROB by up to commitToIEWDelay cycles of commits.
+    // Squashed instructions also linger until the IQ squashes, while
+    // IEW may already dispatch into the ROB slots they freed, so this
+    // is only a starting size and the rings grow when they fill up.
+    size_t inst_list_size = params.numROBEntries + numEntries +
+        params.commitWidth * (params.commitToIEWDelay + 1);
+    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+        instList.emplace_back(inst_list_size);
+        nonSpecInsts.emplace_back(numEntries);
+    }
+
     resetState();
 
     //Figure out resource sharing policy
@@ -392,7 +429,12 @@ InstructionQueue::resetState()
     //Initialize thread IQ counts
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
         count[tid] = 0;
-        instList[tid].clear();
+        for (auto &inst : instList[tid])
+            inst = nullptr;
+        instList[tid].flush();
+        for (auto &entry : nonSpecInsts[tid])
+            entry.second = nullptr;
+        nonSpecInsts[tid].flush();
     }
 
     // Initialize the number of free IQ entries.
@@ -417,7 +459,6 @@ InstructionQueue::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
-    nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
@@ -573,7 +614,7 @@ InstructionQueue::insert(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    pushInstList(new_inst);
 
     --freeEntries;
 
@@ -600,6 +641,21 @@ InstructionQueue::insert(const DynInstPtr &new_inst)
     assert(freeEntries == (numEntries - countInsts()));
 }
 
+void
+InstructionQueue::pushInstList(const DynInstPtr &new_inst)
+{
+    ThreadID tid = new_inst->threadNumber;
+
+    if (instList[tid].full()) {
+        DPRINTF(IQ, "[tid:%i] Growing the instruction list past %i "
+                "entries.\n", tid, instList[tid].capacity());
+        growRing(instList, tid);
+    }
+    assert(instList[tid].empty() ||
+           instList[tid].back()->seqNum < new_inst->seqNum);
+    instList[tid].push_back(new_inst);
+}
+
 void
 InstructionQueue::insertNonSpec(const DynInstPtr &new_inst)
 {
@@ -615,7 +671,16 @@ InstructionQueue::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(new_inst);
 
-    nonSpecInsts[new_inst->seqNum] = new_inst;
+    ThreadID tid = new_inst->threadNumber;
+
+    assert(nonSpecInsts[tid].empty() ||
+           nonSpecInsts[tid].back().first < new_inst->seqNum);
+    if (nonSpecInsts[tid].full()) {
+        DPRINTF(IQ, "[tid:%i] Growing the non-speculative list past %i "
+                "entries.\n", tid, nonSpecInsts[tid].capacity());
+        growRing(nonSpecInsts, tid);
+    }
+    nonSpecInsts[tid].push_back(NonSpecEntry(new_inst->seqNum, new_inst));
 
     DPRINTF(IQ, "Adding non-speculative instruction [sn:%llu] PC %s "
             "to the IQ.\n",
@@ -623,7 +688,7 @@ InstructionQueue::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    pushInstList(new_inst);
 
     --freeEntries;
 
@@ -915,30 +980,49 @@ InstructionQueue::scheduleReadyInsts()
 }
 
 void
-InstructionQueue::scheduleNonSpec(const InstSeqNum &inst)
+InstructionQueue::scheduleNonSpec(const InstSeqNum &inst, ThreadID tid)
 {
     DPRINTF(IQ, "Marking nonspeculative instruction [sn:%llu] as ready "
             "to execute.\n", inst);
 
-    NonSpecMapIt inst_it = nonSpecInsts.find(inst);
+    NonSpecEntry *entry = findNonSpec(inst, tid);
 
-    assert(inst_it != nonSpecInsts.end());
+    assert(entry);
 
-    ThreadID tid = (*inst_it).second->threadNumber;
+    DynInstPtr ns_inst = std::move(entry->second);
 
-    (*inst_it).second->setAtCommit();
+    ns_inst->setAtCommit();
 
-    (*inst_it).second->setCanIssue();
+    ns_inst->setCanIssue();
 
-    if (!(*inst_it).second->isMemRef()) {
-        addIfReady((*inst_it).second);
+    if (!ns_inst->isMemRef()) {
+        addIfReady(ns_inst);
     } else {
-        memDepUnit[tid].nonSpecInstReady((*inst_it).second);
+        memDepUnit[tid].nonSpecInstReady(ns_inst);
     }
 
-    (*inst_it).second = NULL;
+    retireNonSpec(tid);
+}
+
+InstructionQueue::NonSpecEntry *
+InstructionQueue::findNonSpec(InstSeqNum seq_num, ThreadID tid)
+{
+    auto &insts = nonSpecInsts[tid];
+    auto it = std::lower_bound(insts.begin(), insts.end(), seq_num,
+            [](const NonSpecEntry &entry, InstSeqNum seq)
+            { return entry.first < seq; });
+
+    if (it == insts.end() || (*it).first != seq_num || !(*it).second)
+        return nullptr;
+    return &*it;
+}
 
-    nonSpecInsts.erase(inst_it);
+void
+InstructionQueue::retireNonSpec(ThreadID tid)
+{
+    auto &insts = nonSpecInsts[tid];
+    while (!insts.empty() && !insts.front().second)
+        insts.pop_front();
 }
 
 void
@@ -947,11 +1031,9 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
+        instList[tid].front() = nullptr;
         instList[tid].pop_front();
     }
 
@@ -1180,19 +1262,17 @@ InstructionQueue::squash(ThreadID tid)
 void
 InstructionQueue::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given. They are all at the tail, so truncate the list from there.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
+
+        DynInstPtr squashed_inst = std::move(instList[tid].back());
+        instList[tid].pop_back();
 
-        DynInstPtr squashed_inst = (*squash_it);
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1205,7 +1285,6 @@ InstructionQueue::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
             continue;
         }
 
@@ -1256,13 +1335,13 @@ InstructionQueue::doSquash(ThreadID tid)
 
             } else if (!squashed_inst->isStoreConditional() ||
                        !squashed_inst->isCompleted()) {
-                NonSpecMapIt ns_inst_it =
-                    nonSpecInsts.find(squashed_inst->seqNum);
+                NonSpecEntry *ns_entry =
+                    findNonSpec(squashed_inst->seqNum, tid);
 
                 // we remove non-speculative instructions from
                 // nonSpecInsts already when they are ready, and so we
                 // cannot always expect to find them
-                if (ns_inst_it == nonSpecInsts.end()) {
+                if (!ns_entry) {
                     // loads that became ready but stalled on a
                     // blocked cache are alreayd removed from
                     // nonSpecInsts, and have not faulted
@@ -1270,9 +1349,7 @@ InstructionQueue::doSquash(ThreadID tid)
                            squashed_inst->isMemRef());
                 } else {
 
-                    (*ns_inst_it).second = NULL;
-
-                    nonSpecInsts.erase(ns_inst_it);
+                    ns_entry->second = NULL;
 
                     ++iqStats.squashedNonSpecRemoved;
                 }
@@ -1314,9 +1391,17 @@ InstructionQueue::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
+
+    // The squashed non-speculative instructions are the tail of their
+    // list as well.
+    while (!nonSpecInsts[tid].empty() &&
+           nonSpecInsts[tid].back().first > squashedSeqNum[tid]) {
+        nonSpecInsts[tid].back().second = nullptr;
+        nonSpecInsts[tid].pop_back();
+    }
+    retireNonSpec(tid);
 }
 
 bool
@@ -1462,21 +1547,22 @@ InstructionQueue::dumpLists()
         cprintf("\n");
     }
 
-    cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
+    for (ThreadID tid = 0; tid < numThreads; ++tid) {
+        cprintf("Non speculative list %i size: %i\n", tid,
+                nonSpecInsts[tid].size());
 
-    NonSpecMapIt non_spec_it = nonSpecInsts.begin();
-    NonSpecMapIt non_spec_end_it = nonSpecInsts.end();
+        cprintf("Non speculative list: ");
 
-    cprintf("Non speculative list: ");
+        for (auto &entry : nonSpecInsts[tid]) {
+            if (entry.second) {
+                cprintf("%s [sn:%llu]", entry.second->pcState(),
+                        entry.first);
+            }
+        }
 
-    while (non_spec_it != non_spec_end_it) {
-        cprintf("%s [sn:%llu]", (*non_spec_it).second->pcState(),
-                (*non_spec_it).second->seqNum);
-        ++non_spec_it;
+        cprintf("\n");
     }
 
-    cprintf("\n");
-
     ListOrderIt list_order_it = listOrder.begin();
     ListOrderIt list_order_end_it = listOrder.end();
     int i = 1;
@@ -1501,7 +1587,7 @@ InstructionQueue::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        auto inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -43,10 +43,11 @@
 #define __CPU_O3_INST_QUEUE_HH__
 
 #include <list>
-#include <map>
 #include <queue>
+#include <utility>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -226,7 +227,7 @@ class InstructionQueue
     void scheduleReadyInsts();
 
     /** Schedules a single specific non-speculative instruction. */
-    void scheduleNonSpec(const InstSeqNum &inst);
+    void scheduleNonSpec(const InstSeqNum &inst, ThreadID tid);
 
     /**
      * Commits all instructions up to and including the given sequence number,
@@ -316,8 +317,17 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Issued instructions stay on it until commit, so each thread's ring
+     *  is sized by the ROB rather than the IQ, and grows if that is not
+     *  enough.
+     */
+    std::vector<CircularQueue<DynInstPtr>> instList;
+
+    /** Appends an instruction to its thread's list, growing the ring if
+     *  it is full.
+     */
+    void pushInstList(const DynInstPtr &new_inst);
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -355,16 +365,26 @@ class InstructionQueue
      */
     ReadyInstQueue readyInsts[Num_OpClasses];
 
-    /** List of non-speculative instructions that will be scheduled
-     *  once the IQ gets a signal from commit.  While it's redundant to
-     *  have the key be a part of the value (the sequence number is stored
-     *  inside of DynInst), when these instructions are woken up only
-     *  the sequence number will be available.  Thus it is most efficient to be
-     *  able to search by the sequence number alone.
+    /** Entry of a non-speculative instruction, keyed by its sequence
+     *  number. The instruction is cleared once it has been scheduled.
+     */
+    typedef std::pair<InstSeqNum, DynInstPtr> NonSpecEntry;
+
+    /** Per thread list of non-speculative instructions that will be
+     *  scheduled once the IQ gets a signal from commit.  When these
+     *  instructions are woken up only the sequence number is available,
+     *  so the entries are kept in sequence number order and searched by
+     *  it alone.
+     */
+    std::vector<CircularQueue<NonSpecEntry>> nonSpecInsts;
+
+    /** Finds the entry of a non-speculative instruction that has not been
+     *  scheduled yet, or returns nullptr.
      */
-    std::map<InstSeqNum, DynInstPtr> nonSpecInsts;
+    NonSpecEntry *findNonSpec(InstSeqNum seq_num, ThreadID tid);
 
-    typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
+    /** Drops scheduled entries from the head of a thread's list. */
+    void retireNonSpec(ThreadID tid);
 
     /** Entry for the list age ordering by op class. */
     struct ListOrderEntry
@@ -973,6 +973,7 @@ LSQ::SplitDataRequest::initiateTranslation()
                 _size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId());
     _mainReq->setByteEnable(_byteEnable);
+    _mainReq->setNumFlush(_inst->cpu->getNumFlush(_inst->threadNumber));
 
     // Paddr is not used in _mainReq. However, we will accumulate the flags
     // from the sub requests into _mainReq by calling setFlags() in finish().
@@ -1089,6 +1090,7 @@ LSQ::LSQRequest::addReq(Addr addr, unsigned size,
                 _inst->pcState().instAddr(), _inst->contextId(),
                 std::move(_amo_op));
         req->setByteEnable(byte_enable);
+        req->setNumFlush(_inst->cpu->getNumFlush(_inst->threadNumber));
         _reqs.push_back(req);
     }
 }
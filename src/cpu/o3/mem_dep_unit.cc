@@ -68,7 +68,7 @@ MemDepUnit::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
 
         MemDepHashIt hash_it;
 
@@ -202,8 +202,6 @@ MemDepUnit::insert(const DynInstPtr &inst)
 
     instList[tid].push_back(inst);
 
-    inst_entry->listIt = --(instList[tid].end());
-
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
     std::vector<InstSeqNum>  producing_stores;
@@ -336,8 +334,6 @@ MemDepUnit::insertBarrier(const DynInstPtr &barr_inst)
     // Add the instruction to the instruction list.
     instList[tid].push_back(barr_inst);
 
-    inst_entry->listIt = --(instList[tid].end());
-
     insertBarrierSN(barr_inst);
 }
 
@@ -414,7 +410,7 @@ MemDepUnit::completed(const DynInstPtr &inst)
 
     assert(hash_it != memDepHash.end());
 
-    instList[tid].erase((*hash_it).second->listIt);
+    instList[tid].erase(instList[tid].iteratorTo(inst.get()));
 
     (*hash_it).second = NULL;
 
@@ -532,7 +528,7 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         }
     }
 
-    ListIt squash_it = instList[tid].end();
+    InstListIt squash_it = instList[tid].end();
     --squash_it;
 
     MemDepHashIt hash_it;
@@ -617,7 +613,7 @@ MemDepUnit::dumpLists()
         cprintf("Instruction list %i size: %i\n",
                 tid, instList[tid].size());
 
-        ListIt inst_list_it = instList[tid].begin();
+        InstListIt inst_list_it = instList[tid].begin();
         int num = 0;
 
         while (inst_list_it != instList[tid].end()) {
@@ -171,6 +171,8 @@ class MemDepUnit
 
     typedef typename std::list<DynInstPtr>::iterator ListIt;
 
+    typedef DynInstList<InMemDepUnit>::iterator InstListIt;
+
     class MemDepEntry;
 
     typedef std::shared_ptr<MemDepEntry> MemDepEntryPtr;
@@ -194,9 +196,6 @@ class MemDepUnit
         /** The instruction being tracked. */
         DynInstPtr inst;
 
-        /** The iterator to the instruction's location inside the list. */
-        ListIt listIt;
-
         /** A vector of any dependent instructions. */
         std::vector<MemDepEntryPtr> dependInsts;
 
@@ -231,7 +230,7 @@ class MemDepUnit
     MemDepHash memDepHash;
 
     /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[MaxThreads];
+    DynInstList<InMemDepUnit> instList[MaxThreads];
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
@@ -549,6 +549,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     RequestPtr req = std::make_shared<Request>(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
+    req->setNumFlush(getNumFlush(curThread));
 
     req->taskId(taskId());
 
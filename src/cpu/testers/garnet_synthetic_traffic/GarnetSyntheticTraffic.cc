@@ -81,13 +81,20 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
       size(p.memory_size),
       blockSizeBits(p.block_offset),
       numDestinations(p.num_dest),
-      simCycles(p.sim_cycles),
+      simCycles(p.sim_cycles < 0 ? MaxTick : p.sim_cycles),
       numPacketsMax(p.num_packets_max),
       numPacketsSent(0),
       singleSender(p.single_sender),
       singleDest(p.single_dest),
       trafficType(p.traffic_type),
       injRate(p.inj_rate),
+      multicastFraction(p.multicast_fraction),
+      broadcastFraction(p.broadcast_fraction),
+      multicastDestsMin(p.multicast_dests_min),
+      multicastDestsMax(p.multicast_dests_max),
+      multicastDestsGeometric(p.multicast_dests_dist == "geometric"),
+      hotspotFraction(p.hotspot_fraction),
+      hotspotDest(p.hotspot_dest),
       injVnet(p.inj_vnet),
       precision(p.precision),
       responseLimit(p.response_limit),
@@ -103,6 +110,24 @@ GarnetSyntheticTraffic::GarnetSyntheticTraffic(const Params &p)
     }
     traffic = trafficStringToEnum[trafficType];
 
+    if (p.multicast_dests_dist != "uniform" &&
+        p.multicast_dests_dist != "geometric") {
+        fatal("Unknown multicast destination distribution: %s!\n",
+              p.multicast_dests_dist);
+    }
+    fatal_if(multicastFraction + broadcastFraction > 1.0,
+             "Multicast and broadcast fractions add up to more than 1\n");
+    // The set sizes only matter once multicasts are sent, so plain
+    // unicast runs with fewer destinations keep the defaults
+    fatal_if(multicastFraction > 0 &&
+             (multicastDestsMin < 1 ||
+              multicastDestsMin > multicastDestsMax ||
+              multicastDestsMax > numDestinations),
+             "Multicast destination set sizes must lie in [1, %d]\n",
+             numDestinations);
+    fatal_if(hotspotDest < 0 || hotspotDest >= numDestinations,
+             "Hotspot destination %d does not exist\n", hotspotDest);
+
     id = TESTER_NETWORK++;
     DPRINTF(GarnetSyntheticTraffic,"Config Created: Name = %s , and id = %d\n",
             name(), id);
@@ -121,6 +146,13 @@ void
 GarnetSyntheticTraffic::init()
 {
     numPacketsSent = 0;
+
+    // Testers on different event queues run on different host threads,
+    // so each one draws from its own generator.
+    if (numMainEventQueues > 1) {
+        localRandom =
+            std::make_unique<Random>(random_mt.random<uint32_t>());
+    }
 }
 
 
@@ -151,7 +183,7 @@ GarnetSyntheticTraffic::tick()
     // - send pkt if this number is < injRate*(10^precision)
     bool sendAllowedThisCycle;
     double injRange = pow((double) 10, (double) precision);
-    unsigned trySending = random_mt.random<unsigned>(0, (int) injRange);
+    unsigned trySending = rng().random<unsigned>(0, (int) injRange);
     if (trySending < injRate*injRange)
         sendAllowedThisCycle = true;
     else
@@ -196,7 +228,7 @@ GarnetSyntheticTraffic::generatePkt()
     {
         destination = singleDest;
     } else if (traffic == UNIFORM_RANDOM_) {
-        destination = random_mt.random<unsigned>(0, num_destinations - 1);
+        destination = rng().random<unsigned>(0, num_destinations - 1);
     } else if (traffic == BIT_COMPLEMENT_) {
         dest_x = radix - src_x - 1;
         dest_y = radix - src_y - 1;
@@ -241,6 +273,12 @@ GarnetSyntheticTraffic::generatePkt()
         fatal("Unknown Traffic Type: %s!\n", traffic);
     }
 
+    if (singleDest < 0 && hotspotFraction > 0 &&
+        rng().random<double>() < hotspotFraction) {
+        destination = hotspotDest;
+    }
+    TrafficClass traffic_class = pickTrafficClass();
+
     // The source of the packets is a cache.
     // The destination of the packets is a directory.
     // The destination bits are embedded in the address after byte-offset.
@@ -285,7 +323,7 @@ GarnetSyntheticTraffic::generatePkt()
     if (injReqType < 0 || injReqType > 2)
     {
         // randomly inject in any vnet
-        injReqType = random_mt.random(0, 2);
+        injReqType = rng().random(0, 2);
     }
 
     if (injReqType == 0) {
@@ -308,6 +346,8 @@ GarnetSyntheticTraffic::generatePkt()
     }
 
     req->setContext(id);
+    // Read by Garnet_standalone with rpm_packet_type 3
+    req->setTrafficDests(pickDestinations(traffic_class, destination));
 
     //No need to do functional simulation
     //We just do timing simulation of the network
@@ -323,6 +363,52 @@ GarnetSyntheticTraffic::generatePkt()
     sendPkt(pkt);
 }
 
+TrafficClass
+GarnetSyntheticTraffic::pickTrafficClass()
+{
+    double pick = rng().random<double>();
+    if (pick < broadcastFraction)
+        return BROADCAST_;
+    else if (pick < broadcastFraction + multicastFraction)
+        return MULTICAST_;
+    else
+        return UNICAST_;
+}
+
+int
+GarnetSyntheticTraffic::pickMulticastSize()
+{
+    if (!multicastDestsGeometric)
+        return rng().random<int>(multicastDestsMin, multicastDestsMax);
+
+    int num_dests = multicastDestsMin;
+    while (num_dests < multicastDestsMax && rng().random<int>(0, 1))
+        num_dests++;
+    return num_dests;
+}
+
+std::vector<int>
+GarnetSyntheticTraffic::pickDestinations(TrafficClass traffic_class,
+                                         unsigned destination)
+{
+    std::vector<int> dests;
+    if (traffic_class == BROADCAST_) {
+        for (int i = 0; i < numDestinations; i++)
+            dests.push_back(i);
+        return dests;
+    }
+
+    // A multicast always covers the pattern's destination and adds
+    // distinct random ones around it.
+    int num_dests = traffic_class == MULTICAST_ ? pickMulticastSize() : 1;
+    std::set<int> dest_set = {(int) destination};
+    while ((int) dest_set.size() < num_dests) {
+        dest_set.insert(rng().random<int>(0, numDestinations - 1));
+    }
+    dests.assign(dest_set.begin(), dest_set.end());
+    return dests;
+}
+
 void
 GarnetSyntheticTraffic::initTrafficType()
 {
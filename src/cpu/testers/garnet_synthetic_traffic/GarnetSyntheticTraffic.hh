@@ -29,8 +29,11 @@
 #ifndef __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 #define __CPU_GARNET_SYNTHETIC_TRAFFIC_HH__
 
+#include <memory>
 #include <set>
+#include <vector>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/GarnetSyntheticTraffic.hh"
@@ -53,6 +56,12 @@ enum TrafficType {BIT_COMPLEMENT_ = 0,
                   UNIFORM_RANDOM_ = 7,
                   NUM_TRAFFIC_PATTERNS_};
 
+// Destination set of a packet
+enum TrafficClass {UNICAST_ = 0,
+                   MULTICAST_ = 1,
+                   BROADCAST_ = 2,
+                   NUM_TRAFFIC_CLASSES_};
+
 class Packet;
 class GarnetSyntheticTraffic : public ClockedObject
 {
@@ -65,6 +74,8 @@ class GarnetSyntheticTraffic : public ClockedObject
     // main simulation loop (one cycle)
     void tick();
 
+    void setInjRate(double inj_rate) { injRate = inj_rate; }
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -119,7 +130,7 @@ class GarnetSyntheticTraffic : public ClockedObject
     Tick noResponseCycles;
 
     int numDestinations;
-    Tick simCycles;
+    Tick simCycles; // MaxTick when sim_cycles is negative
     int numPacketsMax;
     int numPacketsSent;
     int singleSender;
@@ -128,6 +139,13 @@ class GarnetSyntheticTraffic : public ClockedObject
     std::string trafficType; // string
     TrafficType traffic; // enum from string
     double injRate;
+    double multicastFraction;
+    double broadcastFraction;
+    int multicastDestsMin;
+    int multicastDestsMax;
+    bool multicastDestsGeometric;
+    double hotspotFraction;
+    int hotspotDest;
     int injVnet;
     int precision;
 
@@ -135,9 +153,16 @@ class GarnetSyntheticTraffic : public ClockedObject
 
     RequestorID requestorId;
 
+    std::unique_ptr<Random> localRandom;
+    Random &rng() { return localRandom ? *localRandom : random_mt; }
+
     void completeRequest(PacketPtr pkt);
 
     void generatePkt();
+    TrafficClass pickTrafficClass();
+    int pickMulticastSize();
+    std::vector<int> pickDestinations(TrafficClass traffic_class,
+                                      unsigned destination);
     void sendPkt(PacketPtr pkt);
     void initTrafficType();
 
@@ -27,6 +27,7 @@
 from m5.objects.ClockedObject import ClockedObject
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import cxxMethod
 
 class GarnetSyntheticTraffic(ClockedObject):
     type = 'GarnetSyntheticTraffic'
@@ -37,7 +38,8 @@ class GarnetSyntheticTraffic(ClockedObject):
     block_offset = Param.Int(6, "block offset in bits")
     num_dest = Param.Int(1, "Number of Destinations")
     memory_size = Param.Int(65536, "memory size")
-    sim_cycles = Param.Int(1000, "Number of simulation cycles")
+    sim_cycles = Param.Int(1000, "Number of simulation cycles. \
+                           -1 runs until the simulate() call returns")
     num_packets_max = Param.Int(-1, "Max number of packets to send. \
                         Default is to keep sending till simulation ends")
     single_sender = Param.Int(-1, "Send only from this node. \
@@ -46,6 +48,19 @@ class GarnetSyntheticTraffic(ClockedObject):
                                  Default depends on traffic_type")
     traffic_type = Param.String("uniform_random", "Traffic type")
     inj_rate = Param.Float(0.1, "Packet injection rate")
+    multicast_fraction = Param.Float(0.0, "Fraction of packets sent to \
+                                           a set of destinations")
+    broadcast_fraction = Param.Float(0.0, "Fraction of packets sent to \
+                                           every destination")
+    multicast_dests_min = Param.Int(2, "Smallest multicast destination set")
+    multicast_dests_max = Param.Int(16, "Largest multicast destination set")
+    multicast_dests_dist = Param.String("uniform", "Distribution of the \
+                        multicast destination set size between min and \
+                        max: uniform, or geometric where every extra \
+                        destination is half as likely")
+    hotspot_fraction = Param.Float(0.0, "Fraction of packets that go to \
+                                         the hotspot destination")
+    hotspot_dest = Param.Int(0, "Hotspot destination")
     inj_vnet = Param.Int(-1, "Vnet to inject in. \
                               0 and 1 are 1-flit, 2 is 5-flit. \
                                 Default is to inject in all three vnets")
@@ -54,4 +69,9 @@ class GarnetSyntheticTraffic(ClockedObject):
     response_limit = Param.Cycles(5000000, "Cycles before exiting \
                                             due to lack of progress")
     test = RequestPort("Port to the memory system to test")
+
+    @cxxMethod
+    def setInjRate(self, inj_rate):
+        """Change the injection rate, e.g. between sweep phases"""
+        pass
     system = Param.System(Parent.any, "System we belong to")
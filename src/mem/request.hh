@@ -447,6 +447,20 @@ class Request
     /** The cause for HTM transaction abort */
     HtmFailureFaultCause _htmAbortCause = HtmFailureFaultCause::INVALID;
 
+    /**
+     * Number of consecutive cache lines covered by a cache
+     * maintenance (CLFLUSH) request, as set by the issuing thread
+     * through m5_set_numflush.
+     */
+    uint64_t _numFlush = 1;
+
+    /**
+     * Destination nodes picked by the Garnet synthetic traffic
+     * generator for a multicast or broadcast packet. Empty for every
+     * other request.
+     */
+    std::vector<int> _trafficDests;
+
   public:
 
     /**
@@ -490,6 +504,8 @@ class Request
           _extraData(other._extraData), _contextId(other._contextId),
           _pc(other._pc), _reqInstSeqNum(other._reqInstSeqNum),
           _localAccessor(other._localAccessor),
+          _numFlush(other._numFlush),
+          _trafficDests(other._trafficDests),
           translateDelta(other.translateDelta),
           accessDelta(other.accessDelta), depth(other.depth)
     {
@@ -845,6 +861,20 @@ class Request
         return _contextId;
     }
 
+    /** Accessor function for the number of lines to flush.*/
+    uint64_t getNumFlush() const { return _numFlush; }
+
+    void setNumFlush(uint64_t num_flush) { _numFlush = num_flush; }
+
+    /** Accessor functions for the synthetic traffic destinations.*/
+    const std::vector<int> &getTrafficDests() const { return _trafficDests; }
+
+    void
+    setTrafficDests(const std::vector<int> &dests)
+    {
+        _trafficDests = dests;
+    }
+
     bool
     hasStreamId() const
     {
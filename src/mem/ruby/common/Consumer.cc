@@ -48,22 +48,27 @@ namespace ruby
 
 Consumer::Consumer(ClockedObject *_em)
     : m_wakeup_event([this]{ processCurrentEvent(); },
-                    "Consumer Event", false),
+                    _em->name() + ".consumer", false),
       em(_em)
 { }
 
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
-    scheduleNextWakeup();
+    insertWakeup(em->clockEdge(timeDelta));
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    insertWakeup(divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+}
+
+void
+Consumer::insertWakeup(Tick when)
+{
+    m_wakeup_ticks.advance(em->clockEdge(), em->clockPeriod());
+    m_wakeup_ticks.insert(when);
     scheduleNextWakeup();
 }
 
@@ -71,9 +76,9 @@ void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    m_wakeup_ticks.advance(em->clockEdge(), em->clockPeriod());
+    Tick when = m_wakeup_ticks.next();
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -85,8 +90,8 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
+    Tick curr = em->clockEdge();
+    assert(m_wakeup_ticks.contains(curr));
 
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
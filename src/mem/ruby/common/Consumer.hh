@@ -48,8 +48,8 @@
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
 #include <iostream>
-#include <set>
 
+#include "mem/ruby/common/WakeupRing.hh"
 #include "sim/clocked_object.hh"
 
 namespace gem5
@@ -74,7 +74,7 @@ class Consumer
     bool
     alreadyScheduled(Tick time)
     {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
+        return m_wakeup_ticks.contains(time);
     }
 
     ClockedObject *
@@ -87,10 +87,11 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    WakeupRing m_wakeup_ticks;
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    void insertWakeup(Tick when);
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -28,10 +28,13 @@
 
 #include "mem/ruby/common/FlushAddr.hh"
 
+#include <algorithm>
+#include <cassert>
+
+#include "base/logging.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_Util.hh"
-
-//#include "debug/Clflush.hh"
+#include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
 {
@@ -40,63 +43,124 @@ namespace ruby
 {
 
 void
-FlushAddr::addAddrToTable(int flush_num, Addr addr, MachineType type, int low_bit, int num_bit, int id)
+FlushAddr::addAddrToTable(int flush_num, Addr addr, MachineType type,
+                          int low_bit, int num_bit, int id)
 {
-    for (int i = 0; i < flush_num; i++) {
-        MachineID newElement = mapAddressToRange(addr, type, low_bit, num_bit, intToID(id));
-        int nid = newElement.num;
+    assert(flush_num >= 0);
+    m_base = addr;
+    m_count = flush_num;
+    m_line_bits = RubySystem::getBlockSizeBits();
+    m_type = type;
+    m_low_bit = low_bit;
+    m_num_bits = num_bit;
+    m_cluster = id;
+}
 
-        unordered_map<int, vector<Addr>>::const_iterator got = addr_table.find(nid);
-        if (got != addr_table.end()) {
-            addr_table[nid].push_back(addr);
-        }
-        else {
-            vector<Addr> tmp;
-            tmp.push_back(addr);
-            addr_table.insert({nid, tmp});
-        }
-        addr = addr + 64;
-    }
+bool
+FlushAddr::interleavedByLine() const
+{
+    return m_num_bits == 0 || m_low_bit >= m_line_bits;
+}
+
+int
+FlushAddr::localBank(MachineID mid) const
+{
+    if (mid.type != m_type)
+        return -1;
+    int bank = mid.num - numBanks() * m_cluster;
+    if (bank < 0 || bank >= numBanks())
+        return -1;
+    return bank;
 }
 
 Addr
-FlushAddr::getAddr(MachineID mid, int index) const
+FlushAddr::linesBefore(Addr n, int bank) const
 {
-    int nid = mid.num;
-    unordered_map<int, vector<Addr>>::const_iterator got = addr_table.find(nid);
-    assert(got != addr_table.end());
-    Addr ret_addr = addr_table.at(nid)[index];
-    return ret_addr;
+    // Banks own runs of 'chunk' consecutive lines, round-robin over a
+    // period of chunk * numBanks() lines.
+    Addr chunk = Addr(1) << (m_low_bit - m_line_bits);
+    Addr period = chunk * numBanks();
+    Addr start = bank * chunk;
+    Addr rem = n % period;
+    Addr partial = rem > start ? std::min(rem - start, chunk) : 0;
+    return (n / period) * chunk + partial;
 }
 
-bool
-FlushAddr::moreFlushToEnqueue(MachineID mid, int index) const
+Addr
+FlushAddr::nthLine(Addr j, int bank) const
+{
+    Addr chunk = Addr(1) << (m_low_bit - m_line_bits);
+    Addr period = chunk * numBanks();
+    return (j / chunk) * period + bank * chunk + (j % chunk);
+}
+
+int
+FlushAddr::numLines(MachineID mid) const
 {
-    int nid = mid.num;
-    unordered_map<int, vector<Addr>>::const_iterator got = addr_table.find(nid);
-    assert(got != addr_table.end());
-    if ((addr_table.at(nid).size() - 1) > index)
-        return true;
-    else
-        return false;
+    int bank = localBank(mid);
+    if (bank < 0 || m_count == 0)
+        return 0;
+    if (m_num_bits == 0)
+        return m_count;
+
+    if (interleavedByLine()) {
+        Addr first = m_base >> m_line_bits;
+        return linesBefore(first + m_count, bank) -
+               linesBefore(first, bank);
+    }
+
+    // Banks selected by sub-line bits: no closed form, scan the range.
+    int lines = 0;
+    Addr addr = m_base;
+    for (int i = 0; i < m_count; i++) {
+        if (mapAddressToRange(addr, m_type, m_low_bit, m_num_bits,
+                              intToID(m_cluster)) == mid)
+            lines++;
+        addr += Addr(1) << m_line_bits;
+    }
+    return lines;
 }
 
-/*void
-FlushAddr::printTable() const
+Addr
+FlushAddr::getAddr(MachineID mid, int index) const
 {
-    for (auto it : addr_table) {
-        DPRINTF(Clflush, "NodeID: %d\n", it.first);
-        for (int i = 0; i < it.second.size(); i++) {
-            DPRINTF(Clflush, "%#x \n", it.second[i]);
+    int bank = localBank(mid);
+    assert(bank >= 0);
+    assert(index >= 0 && index < numLines(mid));
+    if (m_num_bits == 0)
+        return m_base + (Addr(index) << m_line_bits);
+
+    if (interleavedByLine()) {
+        Addr first = m_base >> m_line_bits;
+        Addr line = nthLine(linesBefore(first, bank) + index, bank);
+        return m_base + ((line - first) << m_line_bits);
+    }
+
+    Addr addr = m_base;
+    for (int i = 0, seen = 0; i < m_count; i++) {
+        if (mapAddressToRange(addr, m_type, m_low_bit, m_num_bits,
+                              intToID(m_cluster)) == mid) {
+            if (seen++ == index)
+                return addr;
         }
+        addr += Addr(1) << m_line_bits;
     }
-}*/
+    panic("FlushAddr: line %d not found for bank %d\n", index, mid.num);
+}
 
+bool
+FlushAddr::moreFlushToEnqueue(MachineID mid, int index) const
+{
+    int lines = numLines(mid);
+    assert(lines > 0);
+    return (lines - 1) > index;
+}
 
 void
 FlushAddr::print(std::ostream& out) const
 {
-    out << "not implemented" << endl;
+    out << "[FlushAddr base=0x" << std::hex << m_base << std::dec
+        << " lines=" << m_count << " banks=" << numBanks() << "]";
 }
 
 } // namespace ruby
@@ -30,35 +30,63 @@
 #define __MEM_RUBY_COMMON_FLUSHADDR_HH__
 
 #include <iostream>
-#include <unordered_map>
-#include <vector>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/MachineID.hh"
 
-using namespace std;
-
 namespace gem5
 {
 
 namespace ruby
 {
 
+/**
+ * Describes the cache lines covered by a multi-line CLFLUSH and which
+ * bank of an address-interleaved cache each of them maps to.
+ *
+ * Only the base address, the line count and the interleaving parameters
+ * are stored, so copying the descriptor along with the message that
+ * carries it is O(1) in the number of lines. The set of lines owned by a
+ * given bank, and the bank mask itself, are derived on demand.
+ */
 class FlushAddr
 {
   public:
     FlushAddr() { }
     ~FlushAddr() { }
 
-    void addAddrToTable(int flush_num, Addr addr, MachineType type, int low_bit, int num_bit, int id);
+    void addAddrToTable(int flush_num, Addr addr, MachineType type,
+                        int low_bit, int num_bit, int id);
     void print(std::ostream& out) const;
-    void printTable() const;
     bool moreFlushToEnqueue(MachineID mid, int index) const;
     Addr getAddr(MachineID mid, int index) const;
 
+    /** Number of lines in the range that map to the bank of mid. */
+    int numLines(MachineID mid) const;
+    /** Whether any line in the range maps to the bank of mid. */
+    bool hasBank(MachineID mid) const { return numLines(mid) > 0; }
+    /** Number of banks the range is interleaved over. */
+    int numBanks() const { return 1 << m_num_bits; }
+    MachineType getType() const { return m_type; }
+    int getCluster() const { return m_cluster; }
 
   private:
-    std::unordered_map<int, vector<Addr>> addr_table;
+    /** Bank index of mid relative to this range's cluster, or -1. */
+    int localBank(MachineID mid) const;
+    /** Lines with line number below n that map to bank. */
+    Addr linesBefore(Addr n, int bank) const;
+    /** Line number of the j-th line (counting from 0) owned by bank. */
+    Addr nthLine(Addr j, int bank) const;
+    /** True when banks are selected by line-number bits only. */
+    bool interleavedByLine() const;
+
+    Addr m_base = 0;
+    int m_count = 0;
+    int m_line_bits = 0;
+    MachineType m_type = MachineType_NUM;
+    int m_low_bit = 0;
+    int m_num_bits = 0;
+    int m_cluster = 0;
 };
 
 inline std::ostream&
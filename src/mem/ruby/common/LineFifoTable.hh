@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * A FIFO of values per address, such as the outstanding requests of a
+ * Sequencer or the messages a MessageBuffer stalls on a line.
+ *
+ * Addresses are kept in an open addressing hash table with linear
+ * probing that is at most half full, so probes stay short. Values live
+ * in a pool of nodes chained into the FIFO of their address and
+ * recycled through a free list. Once the table and the pool have grown
+ * to the number of values in flight, queueing and retiring values does
+ * not allocate. Nodes never move, so a reference obtained from front()
+ * stays valid while other values are inserted.
+ */
+
+#ifndef __MEM_RUBY_COMMON_LINEFIFOTABLE_HH__
+#define __MEM_RUBY_COMMON_LINEFIFOTABLE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+template <typename T>
+class LineFifoTable
+{
+  public:
+    /** Size the table for capacity addresses. */
+    LineFifoTable(int capacity)
+        : m_num_lines(0), m_last_probe_length(0), m_free_list(-1)
+    {
+        assert(capacity > 0);
+        resize(1 << ceilLog2(2 * capacity));
+    }
+
+    /**
+     * Queue a value behind those already queued for the address.
+     * Returns the number of values queued for the address, this one
+     * included.
+     */
+    int
+    insert(Addr addr, T value)
+    {
+        assert(addr != MaxAddr);
+
+        // keep at least half of the slots free
+        if (2 * (m_num_lines + 1) > (int)m_slots.size())
+            resize(2 * m_slots.size());
+
+        int mask = m_slots.size() - 1;
+        int s = home(addr);
+        m_last_probe_length = 1;
+        while (m_slots[s].addr != MaxAddr && m_slots[s].addr != addr) {
+            s = (s + 1) & mask;
+            m_last_probe_length++;
+        }
+
+        int n = allocNode(std::move(value));
+        Slot &slot = m_slots[s];
+        if (slot.addr == MaxAddr) {
+            slot.addr = addr;
+            slot.head = n;
+            slot.count = 0;
+            m_num_lines++;
+        } else {
+            m_nodes[slot.tail].next = n;
+        }
+        slot.tail = n;
+        return ++slot.count;
+    }
+
+    bool contains(Addr addr) const { return findSlot(addr) != -1; }
+
+    int
+    size(Addr addr) const
+    {
+        int s = findSlot(addr);
+        return s == -1 ? 0 : m_slots[s].count;
+    }
+
+    /** Number of addresses with queued values. */
+    int numLines() const { return m_num_lines; }
+    bool empty() const { return m_num_lines == 0; }
+
+    /** Oldest value of the address, which must be present. */
+    T &
+    front(Addr addr)
+    {
+        int s = findSlot(addr);
+        assert(s != -1);
+        return m_nodes[m_slots[s].head].value;
+    }
+
+    /**
+     * Retire the oldest value of the address, and the address once its
+     * FIFO is empty. The value is moved out so the pool does not keep
+     * it alive.
+     */
+    T
+    popFront(Addr addr)
+    {
+        int s = findSlot(addr);
+        assert(s != -1);
+
+        Slot &slot = m_slots[s];
+        int n = slot.head;
+        slot.head = m_nodes[n].next;
+        T value = std::move(m_nodes[n].value);
+        freeNode(n);
+
+        if (--slot.count == 0)
+            eraseSlot(s);
+        return value;
+    }
+
+    /** Retire all the values. */
+    void
+    clear()
+    {
+        for (auto &slot : m_slots) {
+            if (slot.addr == MaxAddr)
+                continue;
+            int n = slot.head;
+            while (n != -1) {
+                int next = m_nodes[n].next;
+                T discard = std::move(m_nodes[n].value);
+                freeNode(n);
+                n = next;
+            }
+            slot.addr = MaxAddr;
+        }
+        m_num_lines = 0;
+    }
+
+    /** Number of slots the last insert() looked at. */
+    int lastProbeLength() const { return m_last_probe_length; }
+
+    /**
+     * Call f(addr, value) for every value, oldest first per address.
+     * The order of the addresses only depends on the sequence of
+     * insertions and removals, so it is the same from run to run.
+     */
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        for (const auto &slot : m_slots) {
+            if (slot.addr == MaxAddr)
+                continue;
+            for (int n = slot.head; n != -1; n = m_nodes[n].next)
+                f(slot.addr, m_nodes[n].value);
+        }
+    }
+
+  private:
+    struct Slot
+    {
+        Addr addr;
+        int head;
+        int tail;
+        int count;
+    };
+
+    struct Node
+    {
+        T value;
+        int next;
+    };
+
+    int
+    home(Addr addr) const
+    {
+        // Fibonacci hashing, the top bits of the product depend on all
+        // the bits of the address
+        uint64_t hash = addr * 0x9e3779b97f4a7c15ULL;
+        return hash >> (64 - floorLog2(m_slots.size()));
+    }
+
+    int
+    findSlot(Addr addr) const
+    {
+        int mask = m_slots.size() - 1;
+        for (int s = home(addr); m_slots[s].addr != MaxAddr;
+             s = (s + 1) & mask) {
+            if (m_slots[s].addr == addr)
+                return s;
+        }
+        return -1;
+    }
+
+    void
+    eraseSlot(int s)
+    {
+        // Backward shift deletion: move up the following addresses of
+        // the probe run that may live in the freed slot, so lookups never
+        // have to skip over deleted slots
+        int mask = m_slots.size() - 1;
+        int hole = s;
+        for (int i = (s + 1) & mask; m_slots[i].addr != MaxAddr;
+             i = (i + 1) & mask) {
+            int h = home(m_slots[i].addr);
+            // i can move to the hole unless its home is in (hole, i]
+            bool stays = hole <= i ? (hole < h && h <= i) :
+                                     (hole < h || h <= i);
+            if (!stays) {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+        m_slots[hole].addr = MaxAddr;
+        m_num_lines--;
+    }
+
+    void
+    resize(int num_slots)
+    {
+        assert(isPowerOf2(num_slots));
+
+        std::vector<Slot> old_slots(num_slots, Slot{MaxAddr, -1, -1, 0});
+        old_slots.swap(m_slots);
+
+        int mask = num_slots - 1;
+        for (const auto &slot : old_slots) {
+            if (slot.addr == MaxAddr)
+                continue;
+            int s = home(slot.addr);
+            while (m_slots[s].addr != MaxAddr)
+                s = (s + 1) & mask;
+            m_slots[s] = slot;
+        }
+    }
+
+    int
+    allocNode(T &&value)
+    {
+        int n = m_free_list;
+        if (n == -1) {
+            n = m_nodes.size();
+            m_nodes.push_back(Node{std::move(value), -1});
+        } else {
+            m_free_list = m_nodes[n].next;
+            m_nodes[n].value = std::move(value);
+            m_nodes[n].next = -1;
+        }
+        return n;
+    }
+
+    void
+    freeNode(int n)
+    {
+        m_nodes[n].next = m_free_list;
+        m_free_list = n;
+    }
+
+    // Power of two number of slots, MaxAddr marks a free slot
+    std::vector<Slot> m_slots;
+    int m_num_lines;
+    int m_last_probe_length;
+
+    std::deque<Node> m_nodes;
+    int m_free_list;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_LINEFIFOTABLE_HH__
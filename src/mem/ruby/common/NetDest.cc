@@ -28,11 +28,9 @@
 
 #include "mem/ruby/common/NetDest.hh"
 
-#include <algorithm>
-#include <map>
-
+#include "base/logging.hh"
 #include "base/random.hh"
-
+#include "mem/ruby/common/FlushAddr.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_ComponentMapping.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_Util.hh"
 #include "mem/ruby/system/RubySystem.hh"
@@ -43,68 +41,48 @@ namespace gem5
 namespace ruby
 {
 
-NetDest::NetDest()
-{
-  resize();
-}
-
-void
-NetDest::add(MachineID newElement)
-{
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
-}
-
 void
 NetDest::addByAddr(int flush_num, Addr addr, MachineType type, int low_bit, int num_bit, int id)
 {
-    int addr_distance = 1 << (RubySystem::getBlockSizeBits());
-    for (int i = 0; i < flush_num; i++) {
-        MachineID newElement = mapAddressToRange(addr, type, low_bit, num_bit, intToID(id));
-        assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-        m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
-        addr = addr + addr_distance;
+    // Add every bank that owns at least one line of the range, without
+    // walking the lines themselves.
+    FlushAddr range;
+    range.addAddrToTable(flush_num, addr, type, low_bit, num_bit, id);
+    for (int bank = 0; bank < range.numBanks(); bank++) {
+        MachineID newElement = {type,
+            (NodeID)(bank + range.numBanks() * id)};
+        if (!range.hasBank(newElement))
+            continue;
+        add(newElement);
     }
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
 void
 NetDest::setNetDest(MachineType machine, const Set& set)
 {
-    // assure that there is only one set of destinations for this machine
-    assert(MachineType_base_level((MachineType)(machine + 1)) -
-           MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
-}
-
-void
-NetDest::remove(MachineID oldElement)
-{
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
-}
-
-void
-NetDest::removeNetDest(const NetDest& netDest)
-{
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (NodeID j = 0; j < BitsPerType; j++) {
+        MachineID mach = {machine, j};
+        if (j < set.getSize() && set.isElement(j)) {
+            add(mach);
+        } else {
+            remove(mach);
+        }
     }
 }
 
 void
-NetDest::clear()
+NetDest::removeNetDest(const NetDest& netDest)
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
@@ -126,63 +104,33 @@ NetDest::broadcast(MachineType machineType)
     }
 }
 
-//For Princeton Network
-std::vector<NodeID>
-NetDest::getAllDest()
-{
-    std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
-        }
-    }
-    return dest;
-}
-
 int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < NumWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
 
-NodeID
-NetDest::elementAt(MachineID index)
-{
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
-}
-
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
-        }
-    }
-    panic("No smallest element of an empty set.");
+    const_iterator it = begin();
+    MachineID mach = {(MachineType)it.m_type,
+                      (NodeID)(it.m_pos % BitsPerType)};
+    return mach;
 }
 
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
-            return mach;
-        }
+    const_iterator it(this, machine * BitsPerType);
+    if (it.m_pos < (machine + 1) * BitsPerType) {
+        MachineID mach = {machine, (NodeID)(it.m_pos % BitsPerType)};
+        return mach;
     }
 
     panic("No smallest element of given MachineType.");
@@ -192,20 +140,17 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
-            return false;
-        }
-    }
-    return true;
+    NetDest all;
+    all.broadcast();
+    return isEqual(all);
 }
 
 // Returns true iff no bits are set
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
             return false;
         }
     }
@@ -216,10 +161,9 @@ NetDest::isEmpty() const
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -228,10 +172,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -240,53 +183,55 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i] & other_netDest.m_bits[i]) {
             return true;
         }
     }
     return false;
 }
 
+// Returns true if the intersection of the two sets is empty
 bool
-NetDest::isSuperset(const NetDest& test) const
+NetDest::intersectionIsEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == test.getSize());
+    return !intersectionIsNotEmpty(other_netDest);
+}
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
+bool
+NetDest::isSuperset(const NetDest& test) const
+{
+    for (int i = 0; i < NumWords; i++) {
+        if (test.m_bits[i] & ~m_bits[i]) {
             return false;
         }
     }
     return true;
 }
 
-bool
-NetDest::isElement(MachineID element) const
-{
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
-}
-
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        if (MachineType_base_count(machine) > BitsPerType)
+            fatal("Number of bits(%d) < size specified(%d). "
+                  "Increase the number of bits and recompile.\n",
+                  BitsPerType, MachineType_base_count(machine));
     }
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_NUM << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+            MachineID mach = {machine, j};
+            out << isElement(mach) << " ";
         }
         out << " - ";
     }
@@ -296,12 +241,7 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return m_bits == n.m_bits;
 }
 
 /**
@@ -334,53 +274,29 @@ NetDest::multicast(MachineType type)
 }
 
 void
-NetDest::removeDestsExcept(std::set<int> dest_nis)
+NetDest::removeDestsExcept(const std::set<int> &dest_nis)
 {
-    std::map<int, std::set<int>> remove_list;
-
-    // Find the destinations to remove.
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                if (dest_nis.find(id) == dest_nis.end()) {
-                    remove_list[i].insert(j);
-                }
-            }
-        }
-    }
-
-    // Remove the desination found in the above loop.
-    for (auto bits : remove_list) {
-        for (auto bit : bits.second) {
-            m_bits[bits.first].remove(bit);
-        }
-    }
+    removeDestsIf([&](NodeID id) {
+        return dest_nis.find(id) == dest_nis.end();
+    });
 }
 
 void
-NetDest::removeDests(std::set<int> dest_nis)
+NetDest::removeDestsIf(const std::function<bool(NodeID)> &pred)
 {
-    std::map<int, std::set<int>> remove_list;
-
-    // Find the destinations to remove.
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                if (dest_nis.find(id) != dest_nis.end()) {
-                    remove_list[i].insert(j);
-                }
-            }
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (pred(*it)) {
+            clearBit(it.m_pos);
         }
     }
+}
 
-    // Remove the desination found in the above loop.
-    for (auto bits : remove_list) {
-        for (auto bit : bits.second) {
-            m_bits[bits.first].remove(bit);
-        }
-    }
+void
+NetDest::removeDests(const std::set<int> &dest_nis)
+{
+    removeDestsIf([&](NodeID id) {
+        return dest_nis.find(id) != dest_nis.end();
+    });
 }
 
 } // namespace ruby
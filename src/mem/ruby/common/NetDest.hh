@@ -29,10 +29,13 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <set>
-#include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/MachineID.hh"
 #include "mem/ruby/common/Set.hh"
@@ -44,12 +47,78 @@ namespace ruby
 {
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations are a single fixed-width bitset, so a NetDest is
+// copied into messages and routes without allocating and set operations
+// work on whole words. Each machine type owns NUMBER_BITS_PER_SET bits,
+// the most machines of a type a Set can hold, so the width only depends
+// on build time constants.
 class NetDest
 {
   public:
+    // Iterates over the destinations in increasing order of their
+    // global node id, MachineType_base_number(type) + num
+    class const_iterator
+    {
+      public:
+        NodeID operator*() const { return m_base + m_pos % BitsPerType; }
+
+        const_iterator &
+        operator++()
+        {
+            seek(m_pos + 1);
+            return *this;
+        }
+
+        bool
+        operator==(const const_iterator &other) const
+        {
+            return m_pos == other.m_pos;
+        }
+
+        bool
+        operator!=(const const_iterator &other) const
+        {
+            return m_pos != other.m_pos;
+        }
+
+      private:
+        friend class NetDest;
+
+        const_iterator(const NetDest *dest, int pos)
+            : m_dest(dest), m_type(-1), m_base(0)
+        {
+            seek(pos);
+        }
+
+        // Move to the first destination at or after bit pos
+        void
+        seek(int pos)
+        {
+            int w = pos / 64;
+            if (w < NumWords) {
+                uint64_t bits = m_dest->m_bits[w] & (~0ULL << (pos % 64));
+                while (!bits && ++w < NumWords)
+                    bits = m_dest->m_bits[w];
+                pos = bits ? w * 64 + findLsbSet(bits) : NumBits;
+            }
+            m_pos = pos;
+
+            if (m_pos < NumBits && m_pos / BitsPerType != m_type) {
+                m_type = m_pos / BitsPerType;
+                m_base = MachineType_base_number((MachineType)m_type);
+            }
+        }
+
+        const NetDest *m_dest;
+        int m_pos;
+        int m_type;
+        NodeID m_base;
+    };
+
     // Constructors
     // creates and empty set
-    NetDest();
+    NetDest() : m_bits{} {}
     explicit NetDest(int bit_size);
 
     NetDest& operator=(const Set& obj);
@@ -57,12 +126,12 @@ class NetDest
     ~NetDest()
     { }
 
-    void add(MachineID newElement);
+    void add(MachineID newElement) { setBit(bitIndex(newElement)); }
     void addNetDest(const NetDest& netDest);
     void setNetDest(MachineType machine, const Set& set);
-    void remove(MachineID oldElement);
+    void remove(MachineID oldElement) { clearBit(bitIndex(oldElement)); }
     void removeNetDest(const NetDest& netDest);
-    void clear();
+    void clear() { m_bits.fill(0); }
     void broadcast();
     void broadcast(MachineType machine);
     int count() const;
@@ -82,21 +151,24 @@ class NetDest
 
     bool isSuperset(const NetDest& test) const;
     bool isSubset(const NetDest& test) const { return test.isSuperset(*this); }
-    bool isElement(MachineID element) const;
+    bool isElement(MachineID element) const
+    {
+        return testBit(bitIndex(element));
+    }
     bool isBroadcast() const;
     bool isEmpty() const;
 
-    // For Princeton Network
-    std::vector<NodeID> getAllDest();
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, NumBits); }
 
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
+    // Checks that every machine type fits and clears the set
     void resize();
-    int getSize() const { return m_bits.size(); }
 
     // get element for a index
-    NodeID elementAt(MachineID index);
+    NodeID elementAt(MachineID index) const { return isElement(index); }
 
     void print(std::ostream& out) const;
 
@@ -106,22 +178,29 @@ class NetDest
     // RPM specifics.
     //---------------------------------------------------------
     void multicast(MachineType type);
-    void removeDestsExcept(std::set<int> dest_nis);
-    void removeDests(std::set<int> dest_nis);
+    void removeDestsExcept(const std::set<int> &dest_nis);
+    void removeDests(const std::set<int> &dest_nis);
+    // Removes every destination whose global node id satisfies pred
+    void removeDestsIf(const std::function<bool(NodeID)> &pred);
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
+    static constexpr int BitsPerType = NUMBER_BITS_PER_SET;
+    static constexpr int NumBits = MachineType_NUM * BitsPerType;
+    static constexpr int NumWords = (NumBits + 63) / 64;
+
+    // MachineType_base_level(type), the position of the machine type in
+    // the generated tables, is the value of its enum
     int
-    vecIndex(MachineID m) const
+    bitIndex(MachineID m) const
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(m.num < BitsPerType);
+        return m.type * BitsPerType + m.num;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    bool testBit(int i) const { return (m_bits[i / 64] >> (i % 64)) & 1; }
+    void setBit(int i) { m_bits[i / 64] |= 1ULL << (i % 64); }
+    void clearBit(int i) { m_bits[i / 64] &= ~(1ULL << (i % 64)); }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    std::array<uint64_t, NumWords> m_bits;
 };
 
 inline std::ostream&
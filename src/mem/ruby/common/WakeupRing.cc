@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/common/WakeupRing.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+WakeupRing::WakeupRing()
+    : m_base(0), m_period(0), m_span(0), m_head(0), m_bits{}
+{ }
+
+bool
+WakeupRing::slot(Tick when, int &s) const
+{
+    if (when < m_base)
+        return false;
+
+    Tick offset = when - m_base;
+    if (offset >= m_span)
+        return false;
+
+    // the ring spans less than 2^32 ticks, a 32-bit divide is enough
+    uint32_t cycles = (uint32_t)offset / (uint32_t)m_period;
+    if ((uint32_t)offset % (uint32_t)m_period != 0)
+        return false;
+
+    s = (m_head + cycles) % Slots;
+    return true;
+}
+
+void
+WakeupRing::advance(Tick now, Tick period)
+{
+    if (now == m_base && period == m_period)
+        return;
+
+    if (period != m_period || now < m_base) {
+        rebuild(now, period);
+        return;
+    }
+
+    // clear the slots of the edges that went by
+    Tick cycles;
+    if (now - m_base >= m_span) {
+        cycles = (now - m_base) / period;
+        if ((now - m_base) % period != 0) {
+            rebuild(now, period);
+            return;
+        }
+        m_bits.fill(0);
+    } else {
+        int s;
+        if (!slot(now, s)) {
+            rebuild(now, period);
+            return;
+        }
+        cycles = (s - m_head + Slots) % Slots;
+
+        s = m_head;
+        int left = cycles;
+        while (left > 0) {
+            int n = std::min(64 - s % 64, left);
+            m_bits[s / 64] &= ~(mask(n) << (s % 64));
+            s = (s + n) % Slots;
+            left -= n;
+        }
+    }
+
+    m_head = (m_head + cycles) % Slots;
+    m_base = now;
+
+    if (!m_overflow.empty())
+        fill();
+}
+
+void
+WakeupRing::rebuild(Tick now, Tick period)
+{
+    for (int s = 0; s < Slots; s++) {
+        if (testBit(s)) {
+            m_overflow.insert(
+                m_base + ((s - m_head + Slots) % Slots) * m_period);
+        }
+    }
+
+    // Ruby clocks are far faster than the 16us period that would make
+    // the ring span more than 2^32 ticks
+    assert((Tick)Slots * period <= std::numeric_limits<uint32_t>::max());
+
+    m_bits.fill(0);
+    m_base = now;
+    m_period = period;
+    m_span = Slots * period;
+    m_head = 0;
+
+    fill();
+}
+
+void
+WakeupRing::fill()
+{
+    m_overflow.erase(m_overflow.begin(), m_overflow.lower_bound(m_base));
+
+    // wakeups off the clock edges stay in the overflow set
+    Tick end = m_base + m_span;
+    auto it = m_overflow.begin();
+    while (it != m_overflow.end() && *it < end) {
+        int s;
+        if (slot(*it, s)) {
+            m_bits[s / 64] |= 1ULL << (s % 64);
+            it = m_overflow.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool
+WakeupRing::insert(Tick when)
+{
+    int s;
+    if (!slot(when, s))
+        return m_overflow.insert(when).second;
+
+    uint64_t bit = 1ULL << (s % 64);
+    if (m_bits[s / 64] & bit)
+        return false;
+    m_bits[s / 64] |= bit;
+    return true;
+}
+
+bool
+WakeupRing::contains(Tick when) const
+{
+    int s;
+    if (!slot(when, s))
+        return m_overflow.find(when) != m_overflow.end();
+
+    return testBit(s);
+}
+
+void
+WakeupRing::erase(Tick when)
+{
+    int s;
+    if (!slot(when, s)) {
+        m_overflow.erase(when);
+        return;
+    }
+
+    m_bits[s / 64] &= ~(1ULL << (s % 64));
+}
+
+Tick
+WakeupRing::next() const
+{
+    Tick when = MaxTick;
+
+    // scan the ring from the head slot, the head word is visited twice:
+    // first for the slots from the head on, last for the wrapped slots
+    for (int i = 0; i <= Words; i++) {
+        int w = (m_head / 64 + i) % Words;
+        uint64_t bits = m_bits[w];
+        if (i == 0)
+            bits &= ~mask(m_head % 64);
+        else if (i == Words)
+            bits &= mask(m_head % 64);
+
+        if (bits) {
+            int s = w * 64 + findLsbSet(bits);
+            when = m_base + ((s - m_head + Slots) % Slots) * m_period;
+            break;
+        }
+    }
+
+    auto it = m_overflow.lower_bound(m_base);
+    if (it != m_overflow.end() && *it < when)
+        when = *it;
+
+    return when;
+}
+
+bool
+WakeupRing::empty() const
+{
+    for (auto bits : m_bits) {
+        if (bits)
+            return false;
+    }
+    return m_overflow.empty();
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The set of pending wakeup ticks of a Consumer.
+ *
+ * Nearly all wakeups land a few cycles after the current clock edge, so
+ * the next Slots clock edges are kept as a ring of bits indexed by their
+ * cycle offset from the current edge. Inserting, finding and removing
+ * such a wakeup is a bit operation and never allocates. Wakeups further
+ * out, or not on a clock edge of the consumer, go to a std::set and are
+ * moved into the ring once the clock gets close enough.
+ */
+
+#ifndef __MEM_RUBY_COMMON_WAKEUPRING_HH__
+#define __MEM_RUBY_COMMON_WAKEUPRING_HH__
+
+#include <array>
+#include <cstdint>
+#include <set>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class WakeupRing
+{
+  public:
+    static constexpr int Slots = 256;
+
+    WakeupRing();
+
+    /**
+     * Move the ring to the clock edge now. Wakeups before now are
+     * dropped. A changed clock period, or an edge that is not a whole
+     * number of periods after the previous one, rebuilds the ring.
+     */
+    void advance(Tick now, Tick period);
+
+    /** Add a wakeup. Returns false if it was already pending. */
+    bool insert(Tick when);
+
+    bool contains(Tick when) const;
+    void erase(Tick when);
+
+    /** Earliest pending wakeup at or after the ring's edge. */
+    Tick next() const;
+
+    bool empty() const;
+
+  private:
+    static constexpr int Words = Slots / 64;
+
+    // Ring slot of when, false if it is not kept in the ring
+    bool slot(Tick when, int &s) const;
+
+    bool
+    testBit(int s) const
+    {
+        return (m_bits[s / 64] >> (s % 64)) & 1;
+    }
+
+    void rebuild(Tick now, Tick period);
+    void fill();
+
+    // Clock edge of the head slot, the clock period and the ticks
+    // covered by the ring
+    Tick m_base;
+    Tick m_period;
+    Tick m_span;
+    int m_head;
+
+    std::array<uint64_t, Words> m_bits;
+    std::set<Tick> m_overflow;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_WAKEUPRING_HH__
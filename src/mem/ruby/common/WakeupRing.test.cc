@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "mem/ruby/common/WakeupRing.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+const Tick period = 500;
+
+/**
+ * The std::set based wakeup list the ring replaces, driven the same
+ * way Consumer drives it.
+ */
+class WakeupSet
+{
+  public:
+    void advance(Tick now, Tick) { base = now; }
+    bool insert(Tick when) { return ticks.insert(when).second; }
+    bool contains(Tick when) const { return ticks.count(when); }
+    void erase(Tick when) { ticks.erase(when); }
+
+    Tick
+    next() const
+    {
+        auto it = ticks.lower_bound(base);
+        return it == ticks.end() ? MaxTick : *it;
+    }
+
+  private:
+    Tick base = 0;
+    std::set<Tick> ticks;
+};
+
+/**
+ * Run a consumer for the given number of cycles, scheduling wakeups
+ * the way a busy router does: one for the next cycle, some a few
+ * cycles out and now and then one far beyond the ring.
+ */
+template <class Wakeups>
+Tick
+runConsumer(Wakeups &wakeups, Tick cycles)
+{
+    Tick checksum = 0;
+
+    for (Tick c = 0; c < cycles; c++) {
+        Tick now = c * period;
+        wakeups.advance(now, period);
+        wakeups.insert(now + period);
+        if (c % 3 == 0)
+            wakeups.insert(now + 4 * period);
+        if (c % 64 == 0)
+            wakeups.insert(now + 1000 * period);
+        if (wakeups.next() == now) {
+            wakeups.erase(now);
+            checksum += now;
+        }
+    }
+    return checksum;
+}
+
+} // anonymous namespace
+
+TEST(WakeupRingTest, Deduplicates)
+{
+    WakeupRing ring;
+    ring.advance(0, period);
+
+    ASSERT_TRUE(ring.empty());
+    ASSERT_TRUE(ring.insert(3 * period));
+    ASSERT_FALSE(ring.insert(3 * period));
+    ASSERT_TRUE(ring.contains(3 * period));
+    ASSERT_FALSE(ring.contains(2 * period));
+    ASSERT_EQ(ring.next(), 3 * period);
+
+    ring.erase(3 * period);
+    ASSERT_TRUE(ring.empty());
+    ASSERT_EQ(ring.next(), MaxTick);
+}
+
+TEST(WakeupRingTest, WrapsAround)
+{
+    WakeupRing ring;
+    ring.advance(0, period);
+
+    // the last slot of the ring, then an edge past it
+    Tick last = (WakeupRing::Slots - 1) * period;
+    ASSERT_TRUE(ring.insert(last));
+    ASSERT_TRUE(ring.insert(last + 10 * period));
+    ASSERT_EQ(ring.next(), last);
+
+    ring.advance(last, period);
+    ASSERT_EQ(ring.next(), last);
+    ring.erase(last);
+    ASSERT_EQ(ring.next(), last + 10 * period);
+
+    ring.advance(last + 10 * period, period);
+    ASSERT_TRUE(ring.contains(last + 10 * period));
+}
+
+TEST(WakeupRingTest, DropsPastWakeups)
+{
+    WakeupRing ring;
+    ring.advance(0, period);
+    ring.insert(period);
+    ring.insert(4 * period);
+
+    ring.advance(2 * period, period);
+    ASSERT_FALSE(ring.contains(period));
+    ASSERT_EQ(ring.next(), 4 * period);
+}
+
+TEST(WakeupRingTest, OffEdgeWakeups)
+{
+    WakeupRing ring;
+    ring.advance(0, period);
+
+    // wakeups that are not on a clock edge still come out in order
+    ASSERT_TRUE(ring.insert(2 * period + 1));
+    ASSERT_TRUE(ring.insert(3 * period));
+    ASSERT_EQ(ring.next(), 2 * period + 1);
+    ring.erase(2 * period + 1);
+    ASSERT_EQ(ring.next(), 3 * period);
+}
+
+TEST(WakeupRingTest, ClockPeriodChange)
+{
+    WakeupRing ring;
+    ring.advance(0, period);
+    ring.insert(2 * period);
+    ring.insert(6 * period);
+
+    // twice the frequency from the first edge on
+    ring.advance(period, period / 2);
+    ASSERT_TRUE(ring.contains(2 * period));
+    ASSERT_TRUE(ring.contains(6 * period));
+    ASSERT_EQ(ring.next(), 2 * period);
+    ASSERT_TRUE(ring.insert(period + period / 2));
+    ASSERT_EQ(ring.next(), period + period / 2);
+}
+
+TEST(WakeupRingTest, MatchesSet)
+{
+    std::mt19937 rng(1);
+    WakeupRing ring;
+    WakeupSet reference;
+
+    for (Tick now = 0; now < 100000 * period; now += period) {
+        ring.advance(now, period);
+        reference.advance(now, period);
+
+        for (int i = rng() % 4; i > 0; i--) {
+            Tick when = now + (rng() % 600) * period;
+            if (rng() % 32 == 0)
+                when += rng() % period;
+            ASSERT_EQ(ring.insert(when), reference.insert(when));
+        }
+
+        Tick probe = now + (rng() % 300) * period;
+        ASSERT_EQ(ring.contains(probe), reference.contains(probe));
+
+        Tick when = ring.next();
+        ASSERT_EQ(when, reference.next());
+        if (when == now) {
+            ring.erase(now);
+            reference.erase(now);
+        }
+    }
+}
+
+/**
+ * Microbenchmark of the ring against the std::set it replaces. Both
+ * are driven through the same consumer pattern, the timings are only
+ * printed since they depend on the host.
+ */
+TEST(WakeupRingTest, Benchmark)
+{
+    const int cycles = 2000000;
+    using Clock = std::chrono::steady_clock;
+
+    WakeupSet set;
+    auto start = Clock::now();
+    Tick set_sum = runConsumer(set, cycles);
+    std::chrono::duration<double, std::nano> set_time = Clock::now() - start;
+
+    WakeupRing ring;
+    start = Clock::now();
+    Tick ring_sum = runConsumer(ring, cycles);
+    std::chrono::duration<double, std::nano> ring_time = Clock::now() - start;
+
+    ASSERT_EQ(ring_sum, set_sum);
+
+    std::cout << "std::set:   " << set_time.count() / cycles
+              << " ns/cycle" << std::endl;
+    std::cout << "WakeupRing: " << ring_time.count() / cycles
+              << " ns/cycle" << std::endl;
+}
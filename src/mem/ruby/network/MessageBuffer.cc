@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -48,6 +49,7 @@
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/global_event.hh"
 
 namespace gem5
 {
@@ -57,20 +59,41 @@ namespace ruby
 
 using stl_helpers::operator<<;
 
+std::vector<std::unique_ptr<MessageBuffer::CrossingQueue>>
+    MessageBuffer::crossingQueues;
+
 MessageBuffer::MessageBuffer(const Params &p)
-    : SimObject(p), m_stall_map_size(0),
+    : SimObject(p), m_stall_msg_map(InitialLines),
+    m_deferred_msg_map(InitialLines), m_stall_map_size(0),
     m_max_size(p.buffer_size), m_time_last_time_size_checked(0),
     m_time_last_time_enqueue(0), m_time_last_time_pop(0),
     m_last_arrival_time(0), m_strict_fifo(p.ordered),
     m_randomization(p.randomization),
     m_allow_zero_latency(p.allow_zero_latency),
+    m_consumer_eventq(nullptr), m_crossing_queue(nullptr),
+    m_crossing_order(0), m_crossing_size(0), m_crossing_dequeued(false),
+    m_crossing_callback_eventq(nullptr),
+    m_crossing_callback_event([this]{
+        if (m_crossing_callback)
+            m_crossing_callback();
+    }, name() + ".crossingCallback"),
     ADD_STAT(m_not_avail_count, "Number of times this buffer did not have "
                                 "N slots available"),
     ADD_STAT(m_buf_msgs, "Average number of messages in buffer"),
     ADD_STAT(m_stall_time, "Average number of cycles messages are stalled in "
                            "this MB"),
     ADD_STAT(m_stall_count, "Number of times messages were stalled"),
-    ADD_STAT(m_occupancy, "Average occupancy of buffer capacity")
+    ADD_STAT(m_occupancy, "Average occupancy of buffer capacity"),
+    ADD_STAT(m_stall_map_occupancy, "Average number of messages in the "
+                                    "stall map"),
+    ADD_STAT(m_stall_duration, "Ticks messages spend in the stall map"),
+    ADD_STAT(m_wakeups_per_reanalysis, "Number of stalled messages woken "
+                                       "up per reanalysis"),
+    ADD_STAT(m_crossing_count, "Number of messages enqueued from another "
+                               "event queue"),
+    ADD_STAT(m_crossing_late, "Number of messages from another event queue "
+                              "that arrived before the quantum barrier "
+                              "delivering them")
 {
     m_msg_counter = 0;
     m_consumer = NULL;
@@ -80,12 +103,12 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_msgs_this_cycle = 0;
     m_priority_rank = 0;
 
-    m_stall_msg_map.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
 
     m_buf_msgs = 0;
     m_stall_time = 0;
+    m_stall_map_occupancy = 0;
 
     m_dequeue_callback = nullptr;
 
@@ -105,6 +128,23 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_stall_time
         .flags(statistics::nozero);
 
+    m_stall_map_occupancy
+        .flags(statistics::nozero);
+
+    m_stall_duration
+        .init(10)
+        .flags(statistics::nozero | statistics::nonan);
+
+    m_wakeups_per_reanalysis
+        .init(10)
+        .flags(statistics::nozero | statistics::nonan);
+
+    m_crossing_count
+        .flags(statistics::nozero);
+
+    m_crossing_late
+        .flags(statistics::nozero);
+
     if (m_max_size > 0) {
         m_occupancy = m_buf_msgs / m_max_size;
     } else {
@@ -112,6 +152,34 @@ MessageBuffer::MessageBuffer(const Params &p)
     }
 }
 
+void
+MessageBuffer::startup()
+{
+    if (numMainEventQueues <= 1 || !m_consumer)
+        return;
+
+    m_consumer_eventq = m_consumer->getObject()->eventQueue();
+    uint32_t queue = std::find(mainEventQueue.begin(), mainEventQueue.end(),
+                               m_consumer_eventq) - mainEventQueue.begin();
+    assert(queue < numMainEventQueues);
+
+    if (crossingQueues.size() <= queue)
+        crossingQueues.resize(queue + 1);
+    if (!crossingQueues[queue]) {
+        crossingQueues[queue].reset(new CrossingQueue);
+        registerQuantumCallback(queue, [queue]() {
+            deliverCrossings(queue);
+        });
+    }
+
+    // the buffers start up in the same order in every run, which is the
+    // order they are delivered in by deterministic quanta
+    m_crossing_queue = crossingQueues[queue].get();
+    m_crossing_order = m_crossing_queue->buffers++;
+    if (m_max_size > 0)
+        m_crossing_queue->finite.push_back(this);
+}
+
 unsigned int
 MessageBuffer::getSize(Tick curTime)
 {
@@ -132,6 +200,15 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         return true;
     }
 
+    // another queue sees the size as of the last quantum barrier
+    if (crossing()) {
+        std::lock_guard<std::mutex> lock(m_crossing_mutex);
+        if (m_crossing_size + m_crossing_msgs.size() + n <= m_max_size)
+            return true;
+        m_not_avail_count++;
+        return false;
+    }
+
     // determine the correct size for the current cycle
     // pop operations shouldn't effect the network's visible size
     // until schd cycle, but enqueue operations effect the visible
@@ -202,7 +279,6 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
         m_time_last_time_enqueue = current_time;
     }
 
-    m_msg_counter++;
     m_msgs_this_cycle++;
 
     // Calculate the arrival time of the message, that is, the first
@@ -255,8 +331,20 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 
     msg_ptr->updateDelayedTicks(current_time);
     msg_ptr->setLastEnqueueTime(arrival_time);
+
+    if (crossing()) {
+        enqueueCrossing(message, arrival_time);
+        return;
+    }
+
+    m_msg_counter++;
     msg_ptr->setMsgCounter(m_msg_counter);
+    insertMessage(message, arrival_time);
+}
 
+void
+MessageBuffer::insertMessage(MsgPtr message, Tick arrival_time)
+{
     // Insert the message into the priority heap
     m_prio_heap.push_back(message);
     push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
@@ -310,6 +398,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     if (m_dequeue_callback) {
         m_dequeue_callback();
     }
+    m_crossing_dequeued = true;
 
     return delay;
 }
@@ -317,15 +406,103 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 void
 MessageBuffer::registerDequeueCallback(std::function<void()> callback)
 {
+    if (crossing()) {
+        m_crossing_callback = callback;
+        m_crossing_callback_eventq = curEventQueue();
+        return;
+    }
     m_dequeue_callback = callback;
 }
 
 void
 MessageBuffer::unregisterDequeueCallback()
 {
+    if (crossing()) {
+        m_crossing_callback = nullptr;
+        return;
+    }
     m_dequeue_callback = nullptr;
 }
 
+void
+MessageBuffer::enqueueCrossing(MsgPtr message, Tick arrival_time)
+{
+    uint32_t source = deterministicQuanta ? curEventQueueIndex() : 0;
+
+    std::lock_guard<std::mutex> lock(m_crossing_mutex);
+    if (m_crossing_msgs.empty()) {
+        std::lock_guard<std::mutex> queue_lock(m_crossing_queue->mutex);
+        m_crossing_queue->pending.push_back(this);
+    }
+    m_crossing_msgs.push_back({message, arrival_time, source});
+}
+
+void
+MessageBuffer::deliverCrossing()
+{
+    // each producer's messages stay in the order it sent them
+    if (deterministicQuanta) {
+        std::stable_sort(m_crossing_msgs.begin(), m_crossing_msgs.end(),
+            [](const CrossingMsg &a, const CrossingMsg &b) {
+                return a.source < b.source;
+            });
+    }
+
+    Tick now = curTick();
+    for (auto &crossing : m_crossing_msgs) {
+        Tick arrival_time = crossing.arrival_time;
+        if (arrival_time < now) {
+            // the quantum is longer than the latency into this buffer
+            arrival_time = now;
+            crossing.msg->setLastEnqueueTime(now);
+            m_crossing_late++;
+        }
+
+        m_msg_counter++;
+        crossing.msg->setMsgCounter(m_msg_counter);
+        insertMessage(crossing.msg, arrival_time);
+    }
+
+    m_crossing_count += m_crossing_msgs.size();
+    m_crossing_msgs.clear();
+}
+
+void
+MessageBuffer::snapshotCrossing()
+{
+    m_crossing_size = m_prio_heap.size() + m_stall_map_size;
+
+    // space freed up for a producer waiting on another queue
+    if (m_crossing_dequeued && m_crossing_callback_eventq &&
+        !m_crossing_callback_event.scheduled()) {
+        m_crossing_callback_eventq->schedule(&m_crossing_callback_event,
+                                             curTick());
+    }
+    m_crossing_dequeued = false;
+}
+
+void
+MessageBuffer::deliverCrossings(uint32_t queue)
+{
+    // the other queues are stopped at the barrier, no locking needed
+    CrossingQueue &crossing_queue = *crossingQueues[queue];
+
+    if (deterministicQuanta) {
+        std::sort(crossing_queue.pending.begin(),
+                  crossing_queue.pending.end(),
+                  [](const MessageBuffer *a, const MessageBuffer *b) {
+                      return a->m_crossing_order < b->m_crossing_order;
+                  });
+    }
+
+    for (auto buffer : crossing_queue.pending)
+        buffer->deliverCrossing();
+    crossing_queue.pending.clear();
+
+    for (auto buffer : crossing_queue.finite)
+        buffer->snapshotCrossing();
+}
+
 void
 MessageBuffer::clear()
 {
@@ -356,41 +533,42 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::requeueStalledMsg(const StalledMsg &stalled, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
-        assert(m->getLastEnqueueTime() <= schdTick);
+    const MsgPtr &m = stalled.msg;
+    assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+    m_prio_heap.push_back(m);
+    push_heap(m_prio_heap.begin(), m_prio_heap.end(),
+              std::greater<MsgPtr>());
 
-        m_consumer->scheduleEventAbsolute(schdTick);
+    m_consumer->scheduleEventAbsolute(schdTick);
+    m_stall_duration.sample(curTick() - stalled.stall_time);
 
-        DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
-            schdTick, *(m.get()));
-
-        lt.pop_front();
-    }
+    DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
+        schdTick, *(m.get()));
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    assert(m_stall_msg_map.contains(addr));
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The requeueStalledMsg call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    int num_msgs = m_stall_msg_map.size(addr);
+    m_stall_map_size -= num_msgs;
+    m_stall_map_occupancy -= num_msgs;
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    while (m_stall_msg_map.contains(addr)) {
+        requeueStalledMsg(m_stall_msg_map.popFront(addr), current_time);
+    }
+    m_wakeups_per_reanalysis.sample(num_msgs);
 }
 
 void
@@ -398,19 +576,24 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeAllMessages\n");
 
+    // Nothing woke up, so there is nothing to sample either
+    if (m_stall_msg_map.empty())
+        return;
+
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The requeueStalledMsg call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
-        assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
+    m_stall_msg_map.forEach([&](Addr, const StalledMsg &stalled) {
+        requeueStalledMsg(stalled, current_time);
+    });
     m_stall_msg_map.clear();
+
+    m_wakeups_per_reanalysis.sample(m_stall_map_size);
+    m_stall_map_occupancy -= m_stall_map_size;
+    m_stall_map_size = 0;
 }
 
 void
@@ -430,15 +613,16 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    m_stall_msg_map.insert(addr, StalledMsg{message, curTick()});
     m_stall_map_size++;
+    m_stall_map_occupancy++;
     m_stall_count++;
 }
 
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.contains(addr);
 }
 
 void
@@ -446,29 +630,24 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    m_deferred_msg_map.insert(addr, message);
 }
 
 void
 MessageBuffer::enqueueDeferredMessages(Addr addr, Tick curTime, Tick delay)
 {
     assert(!isDeferredMsgMapEmpty(addr));
-    std::vector<MsgPtr>& msg_vec = m_deferred_msg_map[addr];
-    assert(msg_vec.size() > 0);
 
     // enqueue all deferred messages associated with this address
-    for (MsgPtr m : msg_vec) {
-        enqueue(m, curTime, delay);
+    while (m_deferred_msg_map.contains(addr)) {
+        enqueue(m_deferred_msg_map.popFront(addr), curTime, delay);
     }
-
-    msg_vec.clear();
-    m_deferred_msg_map.erase(addr);
 }
 
 bool
 MessageBuffer::isDeferredMsgMapEmpty(Addr addr) const
 {
-    return m_deferred_msg_map.count(addr) == 0;
+    return !m_deferred_msg_map.contains(addr);
 }
 
 void
@@ -513,21 +692,33 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
-                return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
-        }
+    bool read_done = false;
+    m_stall_msg_map.forEach([&](Addr, const StalledMsg &stalled) {
+        if (read_done)
+            return;
+
+        Message *msg = stalled.msg.get();
+        if (is_read && !mask && msg->functionalRead(pkt))
+            read_done = true;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+    });
+
+    if (read_done)
+        return 1;
+
+    // and the messages on their way from another event queue
+    std::lock_guard<std::mutex> lock(m_crossing_mutex);
+    for (auto &crossing : m_crossing_msgs) {
+        Message *msg = crossing.msg.get();
+        if (is_read && !mask && msg->functionalRead(pkt))
+            return 1;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
     }
 
     return num_functional_accesses;
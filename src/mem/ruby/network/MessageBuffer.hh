@@ -50,6 +50,8 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,6 +62,7 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/LineFifoTable.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -77,6 +80,8 @@ class MessageBuffer : public SimObject
     typedef MessageBufferParams Params;
     MessageBuffer(const Params &p);
 
+    void startup() override;
+
     void reanalyzeMessages(Addr addr, Tick current_time);
     void reanalyzeAllMessages(Tick current_time);
     void stallMessage(Addr addr, Tick current_time);
@@ -143,8 +148,8 @@ class MessageBuffer : public SimObject
 
     void recycle(Tick current_time, Tick recycle_latency);
     bool isEmpty() const { return m_prio_heap.size() == 0; }
-    bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
-    unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
+    bool isStallMapEmpty() { return m_stall_msg_map.empty(); }
+    unsigned int getStallMapSize() { return m_stall_msg_map.numLines(); }
 
     unsigned int getSize(Tick curTime);
 
@@ -185,10 +190,55 @@ class MessageBuffer : public SimObject
     }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    struct StalledMsg
+    {
+        MsgPtr msg;
+        Tick stall_time;
+    };
+
+    void requeueStalledMsg(const StalledMsg &, Tick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
+    // Put an enqueued message in the heap and wake up the consumer
+    void insertMessage(MsgPtr message, Tick arrival_time);
+
+    /**
+     * Messages enqueued by a thread running another event queue than the
+     * consumer's are held aside until the next quantum barrier, where
+     * the consumer's thread takes them in. Producers on other queues see
+     * the size of a finite buffer as of that barrier.
+     */
+    struct CrossingMsg
+    {
+        MsgPtr msg;
+        Tick arrival_time;
+        uint32_t source;
+    };
+
+    // The buffers of one event queue that other queues enqueue into
+    struct CrossingQueue
+    {
+        std::mutex mutex;
+        std::vector<MessageBuffer *> pending;
+        std::vector<MessageBuffer *> finite;
+        int buffers = 0;
+    };
+
+    static std::vector<std::unique_ptr<CrossingQueue>> crossingQueues;
+
+    bool
+    crossing() const
+    {
+        return inParallelMode && m_consumer_eventq &&
+            curEventQueue() != m_consumer_eventq;
+    }
+
+    void enqueueCrossing(MsgPtr message, Tick arrival_time);
+    void deliverCrossing();
+    void snapshotCrossing();
+    static void deliverCrossings(uint32_t queue);
+
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
@@ -197,12 +247,16 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    // Lines the stall and deferred message tables are first sized for,
+    // they grow when more lines are held at once
+    static constexpr int InitialLines = 8;
+
+    typedef LineFifoTable<StalledMsg> StallMsgMapType;
 
     /**
-     * A map from line addresses to lists of stalled messages for that line.
+     * A table from line addresses to FIFOs of stalled messages for that
+     * line. Stalling a message and waking up a line take constant time,
+     * and the table iterates in an order that is the same from run to run.
      * If this buffer allows the receiver to stall messages, on a stall
      * request, the stalled message is removed from the m_prio_heap and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
@@ -221,7 +275,7 @@ class MessageBuffer : public SimObject
      * are deferred for enqueueing. Messages in this map are waiting to be
      * enqueued into the message buffer.
      */
-    typedef std::unordered_map<Addr, std::vector<MsgPtr>> DeferredMsgMapType;
+    typedef LineFifoTable<MsgPtr> DeferredMsgMapType;
     DeferredMsgMapType m_deferred_msg_map;
 
     /**
@@ -262,12 +316,33 @@ class MessageBuffer : public SimObject
     int m_input_link_id;
     int m_vnet_id;
 
+    // Event queue of the consumer when there are several, and the
+    // position of this buffer among the buffers of that queue
+    EventQueue *m_consumer_eventq;
+    CrossingQueue *m_crossing_queue;
+    int m_crossing_order;
+
+    std::mutex m_crossing_mutex;
+    std::vector<CrossingMsg> m_crossing_msgs;
+    unsigned int m_crossing_size;
+    bool m_crossing_dequeued;
+
+    // A dequeue callback registered from another queue runs there
+    std::function<void()> m_crossing_callback;
+    EventQueue *m_crossing_callback_eventq;
+    EventFunctionWrapper m_crossing_callback_event;
+
     // Count the # of times I didn't have N slots available
     statistics::Scalar m_not_avail_count;
     statistics::Average m_buf_msgs;
     statistics::Average m_stall_time;
     statistics::Scalar m_stall_count;
     statistics::Formula m_occupancy;
+    statistics::Average m_stall_map_occupancy;
+    statistics::Histogram m_stall_duration;
+    statistics::Histogram m_wakeups_per_reanalysis;
+    statistics::Scalar m_crossing_count;
+    statistics::Scalar m_crossing_late;
 };
 
 Tick random_time();
@@ -52,12 +52,14 @@ enum flit_stage {I_, VA_, SA_, ST_, LT_, NUM_FLIT_STAGE_};
 enum link_type { EXT_IN_, EXT_OUT_, INT_, NUM_LINK_TYPES_ };
 enum RoutingAlgorithm { TABLE_ = 0, XY_ = 1, CUSTOM_ = 2,
                         NUM_ROUTING_ALGORITHM_};
+enum packet_class {UNICAST_PKT_, MULTICAST_PKT_, BROADCAST_PKT_,
+                   NUM_PACKET_CLASS_};
 
 struct RouteInfo
 {
     RouteInfo()
         : vnet(0), src_ni(0), src_router(0), dest_ni(0), dest_router(0),
-          hops_traversed(0)
+          hops_traversed(0), pkt_class(UNICAST_PKT_)
     {}
 
     // destination format for table-based routing
@@ -70,16 +72,17 @@ struct RouteInfo
     int dest_ni;
     int dest_router;
     int hops_traversed;
+
+    // destination set of the message the packet was created for
+    packet_class pkt_class;
     //---------------------------------------------------------
     // RPM specifics.
     //---------------------------------------------------------
     // dest_ni and dest_router variables are not used in RPM
     // and they are set to -1..
-    // Instead, dest_nis and dest_routers are used to have 
-    // multiple destinations.
+    // Instead, net_dest holds the destinations still reached by
+    // this copy of the packet.
     //---------------------------------------------------------
-    std::set<int> dest_nis;
-    std::set<int> dest_routers;
 };
 
 #define INFINITE_ 10000
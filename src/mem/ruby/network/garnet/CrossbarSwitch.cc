@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/CrossbarSwitch.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "debug/RubyNetworkPacket.hh"
 #include "mem/ruby/network/garnet/OutputUnit.hh"
@@ -47,7 +48,7 @@ namespace garnet
 
 CrossbarSwitch::CrossbarSwitch(Router *router)
   : Consumer(router), m_router(router), m_num_vcs(m_router->get_num_vcs()),
-    m_crossbar_activity(0), switchBuffers(0)
+    m_crossbar_activity(0), switchBuffers(0), m_busy_inports(0)
 {
 }
 
@@ -58,9 +59,10 @@ CrossbarSwitch::init()
 }
 
 /*
- * The wakeup function of the CrossbarSwitch loops through all input ports,
- * and sends the winning flit (from SA) out of its output port on to the
- * output link. The output link is scheduled for wakeup in the next cycle.
+ * The wakeup function of the CrossbarSwitch loops through the input ports
+ * holding a flit, and sends the winning flit (from SA) out of its output
+ * port on to the output link. The output link is scheduled for wakeup in
+ * the next cycle.
  */
 
 void
@@ -70,7 +72,10 @@ CrossbarSwitch::wakeup()
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
 
-    for (auto& switch_buffer : switchBuffers) {
+    for (uint64_t inports = m_busy_inports; inports;
+         inports &= inports - 1) {
+        int inport = findLsbSet(inports);
+        flitBuffer &switch_buffer = switchBuffers[inport];
         if (!switch_buffer.isReady(curTick())) {
             continue;
         }
@@ -87,6 +92,8 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            if (switch_buffer.isEmpty())
+                m_busy_inports &= ~(1ULL << inport);
             m_crossbar_activity++;
 
             NDPRINTF(RubyNetworkPacket, t_flit,
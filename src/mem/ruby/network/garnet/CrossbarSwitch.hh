@@ -63,6 +63,7 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_busy_inports |= 1ULL << inport;
     }
 
     inline double get_crossbar_activity() { return m_crossbar_activity; }
@@ -75,6 +76,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    // Inports whose switch buffer holds a flit
+    uint64_t m_busy_inports;
 };
 
 } // namespace garnet
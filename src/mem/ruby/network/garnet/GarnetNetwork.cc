@@ -74,6 +74,7 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_routing_algorithm = p.routing_algorithm;
     m_packet_id = 0;
     m_trace_packet_id = p.trace_packet_id;
+    m_partitioned = false;
     m_enable_rpm = p.enable_rpm;
 
     m_enable_fault_model = p.enable_fault_model;
@@ -158,6 +159,21 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // Routers placed on different event queues (see
+    // configs/network/Network.py) make a partitioned network. Links
+    // between partitions hand their flits and credits over to the
+    // event queue of their consumer.
+    for (auto router : m_routers) {
+        if (router->eventQueue() != m_routers[0]->eventQueue())
+            m_partitioned = true;
+    }
+    if (m_partitioned) {
+        for (auto link : m_networklinks)
+            link->initPartitionCrossing();
+        for (auto link : m_creditlinks)
+            link->initPartitionCrossing();
+    }
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
@@ -490,6 +506,26 @@ GarnetNetwork::regStats()
     m_avg_packet_latency
         = m_avg_packet_network_latency + m_avg_packet_queueing_latency;
 
+    // Packets by destination set. A multicast counts once when injected
+    // and once for every destination that receives it.
+    const char *class_names[NUM_PACKET_CLASS_] =
+        {"unicast", "multicast", "broadcast"};
+
+    m_class_packets_injected
+        .init(NUM_PACKET_CLASS_)
+        .name(name() + ".class_packets_injected")
+        .flags(statistics::total | statistics::nozero | statistics::oneline)
+        ;
+
+    for (int i = 0; i < NUM_PACKET_CLASS_; i++) {
+        m_class_packets_injected.subname(i, class_names[i]);
+        m_class_packet_latency[i]
+            .init(10)
+            .name(name() + ".class_packet_latency_" + class_names[i])
+            .flags(statistics::nozero)
+            ;
+    }
+
     // Flits
     m_flits_received
         .init(m_virtual_networks)
@@ -645,6 +681,20 @@ GarnetNetwork::print(std::ostream& out) const
     out << "[GarnetNetwork]";
 }
 
+packet_class
+GarnetNetwork::get_packet_class(const NetDest &dest)
+{
+    int num_dests = dest.count();
+    if (num_dests <= 1) {
+        return UNICAST_PKT_;
+    }
+    MachineType type = dest.smallestElement().type;
+    if (num_dests == MachineType_base_count(type)) {
+        return BROADCAST_PKT_;
+    }
+    return MULTICAST_PKT_;
+}
+
 void
 GarnetNetwork::update_traffic_distribution(RouteInfo route)
 {
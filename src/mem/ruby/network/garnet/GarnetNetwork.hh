@@ -33,6 +33,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
@@ -114,6 +115,16 @@ class GarnetNetwork : public Network
     void resetStats();
     void print(std::ostream& out) const;
 
+    // Running totals for rate sweeps driven from Python
+    double getPacketsInjected() { return m_packets_injected.total(); }
+    double getPacketsReceived() { return m_packets_received.total(); }
+    double
+    getPacketLatency()
+    {
+        return m_packet_network_latency.total() +
+               m_packet_queueing_latency.total();
+    }
+
     // increment counters
     void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
     void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
@@ -130,6 +141,20 @@ class GarnetNetwork : public Network
         m_packet_queueing_latency[vnet] += latency;
     }
 
+    void
+    increment_class_packets_injected(packet_class pkt_class)
+    {
+        m_class_packets_injected[pkt_class]++;
+    }
+
+    void
+    sample_class_packet_latency(Cycles latency, packet_class pkt_class)
+    {
+        m_class_packet_latency[pkt_class].sample(latency);
+    }
+
+    static packet_class get_packet_class(const NetDest &dest);
+
     void increment_injected_flits(int vnet) { m_flits_injected[vnet]++; }
     void increment_received_flits(int vnet) { m_flits_received[vnet]++; }
 
@@ -154,6 +179,18 @@ class GarnetNetwork : public Network
     void update_traffic_distribution(RouteInfo route);
 
     int get_next_packet_id() { return m_packet_id++; }
+
+    // NIs of different partitions run on different host threads and
+    // share the network-wide stats, packet ids and multicast table.
+    // Hold the returned lock while touching them.
+    bool isPartitioned() const { return m_partitioned; }
+    std::unique_lock<std::mutex>
+    lockShared()
+    {
+        if (!m_partitioned)
+            return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(m_shared_mutex);
+    }
     int get_trace_packet_id() const { return m_trace_packet_id; }
 
     //---------------------------------------------------------
@@ -185,6 +222,9 @@ class GarnetNetwork : public Network
     statistics::Formula m_avg_packet_queueing_latency;
     statistics::Formula m_avg_packet_latency;
 
+    statistics::Vector m_class_packets_injected;
+    statistics::Histogram m_class_packet_latency[NUM_PACKET_CLASS_];
+
     statistics::Vector m_flits_received;
     statistics::Vector m_flits_injected;
     statistics::Vector m_flit_network_latency;
@@ -219,6 +259,8 @@ class GarnetNetwork : public Network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
     int m_packet_id;
     int m_trace_packet_id;
+    bool m_partitioned;
+    std::mutex m_shared_mutex;
     //---------------------------------------------------------
     // RPM specifics.
     //---------------------------------------------------------
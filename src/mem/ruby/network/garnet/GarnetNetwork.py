@@ -30,10 +30,28 @@
 
 from m5.params import *
 from m5.proxy import *
+from m5.SimObject import cxxMethod
 from m5.objects.Network import RubyNetwork
 from m5.objects.BasicRouter import BasicRouter
 from m5.objects.ClockedObject import ClockedObject
 
+class RPMSetAsideArbitration(Enum): vals = [
+    'round_robin',
+    'age',
+    ]
+
+class GarnetSwitchAllocator(Enum): vals = [
+    'separable',
+    'bitset',
+    ]
+
+class MulticastRouting(Enum): vals = [
+    'rpm',
+    'xy_tree',
+    'dual_path',
+    'unicast',
+    ]
+
 class GarnetNetwork(RubyNetwork):
     type = 'GarnetNetwork'
     cxx_header = "mem/ruby/network/garnet/GarnetNetwork.hh"
@@ -53,10 +71,29 @@ class GarnetNetwork(RubyNetwork):
     trace_packet_id = Param.Int(-1, "A packet id to trace");
     enable_rpm = Param.Bool(False, "enable rpm routing");
 
+    # Running totals over all vnets, read between simulate() calls
+    @cxxMethod
+    def getPacketsInjected(self):
+        pass
+
+    @cxxMethod
+    def getPacketsReceived(self):
+        pass
+
+    @cxxMethod
+    def getPacketLatency(self):
+        """Network plus queueing latency of received packets, in ticks"""
+        pass
+
 class RPMGarnetNetwork(GarnetNetwork):
     type = 'RPMGarnetNetwork'
     cxx_header = "mem/ruby/network/garnet/rpm/RPMGarnetNetwork.hh"
     cxx_class = 'gem5::ruby::garnet::RPMGarnetNetwork'
+    multicast_routing = Param.MulticastRouting('rpm',
+                          "rpm: recursive partition multicast, "
+                          "xy_tree: XY routes merged into a tree, "
+                          "dual_path: two Hamiltonian paths from the source, "
+                          "unicast: one XY-routed copy per destination")
 
 class GarnetNetworkInterface(ClockedObject):
     type = 'GarnetNetworkInterface'
@@ -86,8 +123,17 @@ class GarnetRouter(BasicRouter):
                           "number of virtual networks")
     width = Param.UInt32(Parent.ni_flit_size,
                           "bit width supported by the router")
+    switch_allocator = Param.GarnetSwitchAllocator('separable',
+                          "separable: loop over the input VCs and inports; "
+                          "bitset: same grants, picked from packed "
+                          "request masks")
 
 class RPMGarnetRouter(GarnetRouter):
     type = 'RPMGarnetRouter'
     cxx_class = 'gem5::ruby::garnet::RPMRouter'
     cxx_header = "mem/ruby/network/garnet/rpm/RPMRouter.hh"
+    setaside_depth = Param.UInt32(16,
+                          "replicas each set-aside buffer can hold")
+    setaside_arbitration = Param.RPMSetAsideArbitration('round_robin',
+                          "how set-aside replicas compete with input VCs "
+                          "for an output port")
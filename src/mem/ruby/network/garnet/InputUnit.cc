@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/InputUnit.hh"
 
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "debug/RubyNetworkPacket.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
@@ -47,9 +48,11 @@ namespace garnet
 
 InputUnit::InputUnit(int id, PortDirection direction, Router *router)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
-    m_vc_per_vnet(m_router->get_vc_per_vnet())
+    m_vc_per_vnet(m_router->get_vc_per_vnet()), m_busy_vcs(0)
 {
     const int m_num_vcs = m_router->get_num_vcs();
+    fatal_if(m_num_vcs > 64, "Router %d: %d VCs do not fit the busy VC "
+             "mask of an input unit\n", m_router->get_id(), m_num_vcs);
     m_num_buffer_reads.resize(m_num_vcs/m_vc_per_vnet);
     m_num_buffer_writes.resize(m_num_vcs/m_vc_per_vnet);
     for (int i = 0; i < m_num_buffer_reads.size(); i++) {
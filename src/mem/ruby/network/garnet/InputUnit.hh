@@ -66,12 +66,14 @@ class InputUnit : public Consumer
     virtual inline void
     set_vc_idle(int vc, Tick curTime)
     {
+        m_busy_vcs &= ~(1ULL << vc);
         virtualChannels[vc].set_idle(curTime);
     }
 
     virtual inline void
     set_vc_active(int vc, Tick curTime)
     {
+        m_busy_vcs |= 1ULL << vc;
         virtualChannels[vc].set_active(curTime);
     }
 
@@ -140,6 +142,11 @@ class InputUnit : public Consumer
     }
 
     inline int get_inlink_id() { return m_in_link->get_id(); }
+    inline bool is_link_empty() { return m_in_link->isEmpty(); }
+
+    // One bit per VC that holds a packet. Switch allocation only looks
+    // at these VCs.
+    virtual uint64_t get_busy_vcs() { return m_busy_vcs; }
 
     inline void
     set_credit_link(CreditLink *credit_link)
@@ -153,7 +160,7 @@ class InputUnit : public Consumer
     { return m_num_buffer_writes[vnet]; }
 
     uint32_t functionalWrite(Packet *pkt);
-    void resetStats();
+    virtual void resetStats();
 
   protected:
     Router *m_router;
@@ -163,6 +170,7 @@ class InputUnit : public Consumer
     NetworkLink *m_in_link;
     CreditLink *m_credit_link;
     flitBuffer creditQueue;
+    uint64_t m_busy_vcs;
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
@@ -113,6 +113,7 @@ NetworkBridge::scheduleFlit(flit *t_flit, Cycles latency)
     lastScheduledAt = sendTime;
     linkBuffer.insert(t_flit);
     link_consumer->scheduleEventAbsolute(sendTime);
+    notifyArrival();
 }
 
 void
@@ -57,7 +57,8 @@ NetworkInterface::NetworkInterface(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
     m_vc_allocator(m_virtual_networks, 0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
-    vc_busy_counter(m_virtual_networks, 0)
+    vc_busy_counter(m_virtual_networks, 0),
+    m_partial_msg_class(m_virtual_networks, -1)
 {
     m_stall_count.resize(m_virtual_networks);
     niOutVcs.resize(0);
@@ -155,6 +156,7 @@ void
 NetworkInterface::incrementStats(flit *t_flit)
 {
     int vnet = t_flit->get_vnet();
+    auto lock = m_net_ptr->lockShared();
 
     // Latency
     m_net_ptr->increment_received_flits(vnet);
@@ -172,6 +174,9 @@ NetworkInterface::incrementStats(flit *t_flit)
         m_net_ptr->increment_received_packets(vnet);
         m_net_ptr->increment_packet_network_latency(network_delay, vnet);
         m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->sample_class_packet_latency(
+            ticksToCycles(network_delay + queueing_delay),
+            t_flit->get_route().pkt_class);
     }
 
     // Hops
@@ -378,11 +383,13 @@ NetworkInterface::checkStallQueue()
 bool
 NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 {
+    auto lock = m_net_ptr->lockShared();
     Message *net_msg_ptr = msg_ptr.get();
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
-    // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
+    // all the destinations associated with this message, the loop below
+    // only removes those it has already visited from net_msg_dest
+    bool multiple_dests = net_msg_dest.count() > 1;
 
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
@@ -395,20 +402,28 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         m_net_ptr->MessageSizeType_to_int(net_msg_ptr->getMessageSize()),
         vnet, oPort->bitWidth());
 
+    packet_class pkt_class;
+    if (m_partial_msg_class[vnet] == -1) {
+        pkt_class = GarnetNetwork::get_packet_class(net_msg_dest);
+        m_net_ptr->increment_class_packets_injected(pkt_class);
+    } else {
+        pkt_class = (packet_class)m_partial_msg_class[vnet];
+    }
+
     // loop to convert all multicast messages into unicast messages
-    for (int ctr = 0; ctr < dest_nodes.size(); ctr++) {
+    for (NodeID destID : net_msg_dest) {
 
         // this will return a free output virtual channel
         int vc = calculateVC(vnet);
 
         if (vc == -1) {
+            m_partial_msg_class[vnet] = pkt_class;
             return false ;
         }
         MsgPtr new_msg_ptr = msg_ptr->clone();
-        NodeID destID = dest_nodes[ctr];
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
-        if (dest_nodes.size() > 1) {
+        if (multiple_dests) {
             NetDest personal_dest;
             for (int m = 0; m < (int) MachineType_NUM; m++) {
                 if ((destID >= MachineType_base_number((MachineType) m)) &&
@@ -443,6 +458,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // initialize hops_traversed to -1
         // so that the first router increments it to 0
         route.hops_traversed = -1;
+        route.pkt_class = pkt_class;
 
         m_net_ptr->increment_injected_packets(vnet);
         m_net_ptr->update_traffic_distribution(route);
@@ -465,6 +481,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         m_ni_out_vcs_enqueue_time[vc] = curTick();
         outVcState[vc].setState(ACTIVE_, curTick());
     }
+    m_partial_msg_class[vnet] = -1;
     return true ;
 }
 
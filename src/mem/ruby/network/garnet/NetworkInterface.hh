@@ -292,6 +292,11 @@ class NetworkInterface : public ClockedObject, public Consumer
     // When a vc stays busy for a long time, it indicates a deadlock
     std::vector<int> vc_busy_counter;
 
+    // Class of the message partly flitisized on each vnet, or -1. Sent
+    // destinations are removed from the message, so a retry cannot
+    // recompute it.
+    std::vector<int> m_partial_msg_class;
+
     virtual void checkStallQueue();
     virtual bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
     virtual int calculateVC(int vnet);
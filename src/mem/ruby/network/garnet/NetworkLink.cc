@@ -32,6 +32,7 @@
 
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
@@ -50,7 +51,8 @@ NetworkLink::NetworkLink(const Params &p)
       m_type(NUM_LINK_TYPES_),
       m_latency(p.link_latency), m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
-      link_consumer(nullptr), link_srcQueue(nullptr)
+      m_consumer_eventq(nullptr), link_consumer(nullptr),
+      link_srcQueue(nullptr)
 {
     int num_vnets = (p.supported_vnets).size();
     mVnets.resize(num_vnets);
@@ -98,8 +100,17 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        if (m_consumer_eventq) {
+            // The consumer's queue takes the event in at the next
+            // quantum barrier, which comes before the flit arrives.
+            // The flit is placed ahead of the consumer's own wakeup.
+            m_consumer_eventq->schedule(new EventFunctionWrapper(
+                    [this, t_flit]{ deliver(t_flit); },
+                    name() + ".deliver", true, Event::Default_Pri - 1),
+                t_flit->get_time());
+        } else {
+            deliver(t_flit);
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -109,6 +120,30 @@ NetworkLink::wakeup()
     }
 }
 
+void
+NetworkLink::deliver(flit *t_flit)
+{
+    linkBuffer.insert(t_flit);
+    link_consumer->scheduleEventAbsolute(t_flit->get_time());
+    notifyArrival();
+}
+
+void
+NetworkLink::initPartitionCrossing()
+{
+    assert(link_consumer != nullptr);
+    EventQueue *consumer_eventq = link_consumer->getObject()->eventQueue();
+    if (consumer_eventq == eventQueue())
+        return;
+
+    // Flits sent during a quantum must arrive after its barrier
+    fatal_if(cyclesToTicks(m_latency) <= simQuantum,
+             "%s links two partitions, so its latency (%d ticks) must be "
+             "longer than sim_quantum (%d ticks)\n", name(),
+             cyclesToTicks(m_latency), simQuantum);
+    m_consumer_eventq = consumer_eventq;
+}
+
 void
 NetworkLink::resetStats()
 {
@@ -33,6 +33,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 
+#include <functional>
 #include <iostream>
 #include <vector>
 
@@ -61,6 +62,13 @@ class NetworkLink : public ClockedObject, public Consumer
     ~NetworkLink() = default;
 
     void setLinkConsumer(Consumer *consumer);
+    // Called whenever a flit is put on the link, so that the consumer
+    // can tell which of its links have work without polling them all.
+    void
+    setArrivalCallback(std::function<void()> callback)
+    {
+        m_arrival_callback = callback;
+    }
     void setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObject);
     virtual void setVcsPerVnet(uint32_t consumerVcs);
     void setType(link_type type) { m_type = type; }
@@ -69,6 +77,9 @@ class NetworkLink : public ClockedObject, public Consumer
     int get_id() const { return m_id; }
     flitBuffer *getBuffer() { return &linkBuffer;}
     virtual void wakeup();
+    // Called once the consumer is known. A link whose consumer runs on
+    // another event queue delivers its flits through that queue.
+    void initPartitionCrossing();
 
     unsigned int getLinkUtilization() const { return m_link_utilized; }
     const std::vector<unsigned int> & getVcLoad() const { return m_vc_load; }
@@ -78,6 +89,7 @@ class NetworkLink : public ClockedObject, public Consumer
         return linkBuffer.isReady(curTime);
     }
 
+    inline bool isEmpty() { return linkBuffer.isEmpty(); }
     inline flit* peekLink() { return linkBuffer.peekTopFlit(); }
     inline flit* consumeLink() { return linkBuffer.getTopFlit(); }
 
@@ -93,6 +105,7 @@ class NetworkLink : public ClockedObject, public Consumer
     const Cycles m_latency;
 
     ClockedObject *src_object;
+    EventQueue *m_consumer_eventq;
 
     // Statistical variables
     unsigned int m_link_utilized;
@@ -103,6 +116,16 @@ class NetworkLink : public ClockedObject, public Consumer
     flitBuffer linkBuffer;
     Consumer *link_consumer;
     flitBuffer *link_srcQueue;
+    std::function<void()> m_arrival_callback;
+
+    void deliver(flit *t_flit);
+
+    void
+    notifyArrival()
+    {
+        if (m_arrival_callback)
+            m_arrival_callback();
+    }
 
 };
 
@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/OutputUnit.hh"
 
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
@@ -49,12 +50,16 @@ namespace garnet
 OutputUnit::OutputUnit(int id, PortDirection direction, Router *router,
   uint32_t consumerVcs)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
-    m_vc_per_vnet(consumerVcs)
+    m_vc_per_vnet(consumerVcs), m_idle_vcs(0), m_credit_vcs(0)
 {
     const int m_num_vcs = consumerVcs * m_router->get_num_vnets();
+    fatal_if(m_num_vcs > 64, "Router %d: %d output VCs do not fit the "
+             "VC masks of an output unit\n", m_router->get_id(), m_num_vcs);
     outVcState.reserve(m_num_vcs);
     for (int i = 0; i < m_num_vcs; i++) {
         outVcState.emplace_back(i, m_router->get_net_ptr(), consumerVcs);
+        m_idle_vcs |= 1ULL << i;
+        m_credit_vcs |= 1ULL << i;
     }
 }
 
@@ -68,6 +73,8 @@ OutputUnit::decrement_credit(int out_vc)
             out_vc, m_router->curCycle(), m_credit_link->name());
 
     outVcState[out_vc].decrement_credit();
+    if (!outVcState[out_vc].has_credit())
+        m_credit_vcs &= ~(1ULL << out_vc);
 }
 
 void
@@ -80,6 +87,7 @@ OutputUnit::increment_credit(int out_vc)
             out_vc, m_router->curCycle(), m_credit_link->name());
 
     outVcState[out_vc].increment_credit();
+    m_credit_vcs |= 1ULL << out_vc;
 }
 
 // Check if the output VC (i.e., input VC at next router)
@@ -113,7 +121,7 @@ OutputUnit::select_free_vc(int vnet)
     int vc_base = vnet*m_vc_per_vnet;
     for (int vc = vc_base; vc < vc_base + m_vc_per_vnet; vc++) {
         if (is_vc_idle(vc, curTick())) {
-            outVcState[vc].setState(ACTIVE_, curTick());
+            set_vc_state(ACTIVE_, vc, curTick());
             return vc;
         }
     }
@@ -129,6 +137,12 @@ OutputUnit::select_free_vc(int vnet)
  * the output VC is marked IDLE.
  */
 
+bool
+OutputUnit::is_credit_link_empty()
+{
+    return m_credit_link->isEmpty();
+}
+
 void
 OutputUnit::wakeup()
 {
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -62,6 +63,7 @@ class OutputUnit : public Consumer
     void set_out_link(NetworkLink *link);
     void set_credit_link(CreditLink *credit_link);
     void wakeup();
+    bool is_credit_link_empty();
     flitBuffer* getOutQueue();
     void print(std::ostream& out) const {};
     void decrement_credit(int out_vc);
@@ -88,8 +90,22 @@ class OutputUnit : public Consumer
     set_vc_state(VC_state_type state, int vc, Tick curTime)
     {
       outVcState[vc].setState(state, curTime);
+      if (state == IDLE_)
+          m_idle_vcs |= 1ULL << vc;
+      else
+          m_idle_vcs &= ~(1ULL << vc);
     }
 
+    // One bit per idle output VC of the vnet
+    inline uint64_t
+    get_free_vcs(int vnet) const
+    {
+        return m_idle_vcs & (mask(m_vc_per_vnet) << (vnet * m_vc_per_vnet));
+    }
+
+    // One bit per output VC with at least one credit
+    inline uint64_t get_credit_vcs() const { return m_credit_vcs; }
+
     inline bool
     is_vc_idle(int vc, Tick curTime)
     {
@@ -118,6 +134,8 @@ class OutputUnit : public Consumer
     flitBuffer outBuffer;
     // vc state of downstream router
     std::vector<OutVcState> outVcState;
+    uint64_t m_idle_vcs;
+    uint64_t m_credit_vcs;
 };
 
 } // namespace garnet
@@ -32,6 +32,7 @@
 
 #include "mem/ruby/network/garnet/Router.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/rpm/RPMInputUnit.hh"
 #include "mem/ruby/network/garnet/rpm/RPMRoutingUnit.hh"
@@ -54,10 +55,14 @@ Router::Router(const Params &p)
   : BasicRouter(p), Consumer(this), m_latency(p.latency),
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(p.vcs_per_vnet),
     m_num_vcs(m_virtual_networks * m_vc_per_vnet), m_bit_width(p.width),
-    m_network_ptr(nullptr), switchAllocator(this), crossbarSwitch(this)
+    m_network_ptr(nullptr), switchAllocator(this), crossbarSwitch(this),
+    m_active_inports(0), m_active_outports(0)
 {
     m_input_unit.clear();
     m_output_unit.clear();
+
+    switchAllocator.set_bitset_allocation(
+            p.switch_allocator == enums::bitset);
 }
 
 void
@@ -65,6 +70,10 @@ Router::init()
 {
     BasicRouter::init();
 
+    // The active port masks hold one bit per port
+    fatal_if(m_input_unit.size() > 64 || m_output_unit.size() > 64,
+             "Router %d has more than 64 inports or outports\n", m_id);
+
     switchAllocator.init();
     crossbarSwitch.init();
 }
@@ -76,8 +85,12 @@ Router::wakeup()
     assert(clockEdge() == curTick());
 
     // check for incoming flits
-    for (int inport = 0; inport < m_input_unit.size(); inport++) {
+    for (uint64_t inports = m_active_inports; inports;
+         inports &= inports - 1) {
+        int inport = findLsbSet(inports);
         m_input_unit[inport]->wakeup();
+        if (m_input_unit[inport]->is_link_empty())
+            m_active_inports &= ~(1ULL << inport);
     }
 
     // check for incoming credits
@@ -86,8 +99,12 @@ Router::wakeup()
     //     credit traversal (1-cycle) + SA (1-cycle) + Link Traversal (1-cycle)
     // if we want the credit update to take place after SA, this loop should
     // be moved after the SA request
-    for (int outport = 0; outport < m_output_unit.size(); outport++) {
+    for (uint64_t outports = m_active_outports; outports;
+         outports &= outports - 1) {
+        int outport = findLsbSet(outports);
         m_output_unit[outport]->wakeup();
+        if (m_output_unit[outport]->is_credit_link_empty())
+            m_active_outports &= ~(1ULL << outport);
     }
 
     // Switch Allocation
@@ -119,6 +136,8 @@ Router::addInPort(PortDirection inport_dirn,
     input_unit->set_in_link(in_link);
     input_unit->set_credit_link(credit_link);
     in_link->setLinkConsumer(this);
+    in_link->setArrivalCallback([this, port_num]() {
+        m_active_inports |= 1ULL << port_num; });
     in_link->setVcsPerVnet(get_vc_per_vnet());
     credit_link->setSourceQueue(input_unit->getCreditQueue(), this);
     credit_link->setVcsPerVnet(get_vc_per_vnet());
@@ -144,6 +163,8 @@ Router::addOutPort(PortDirection outport_dirn,
     output_unit->set_out_link(out_link);
     output_unit->set_credit_link(credit_link);
     credit_link->setLinkConsumer(this);
+    credit_link->setArrivalCallback([this, port_num]() {
+        m_active_outports |= 1ULL << port_num; });
     credit_link->setVcsPerVnet(consumerVcs);
     out_link->setSourceQueue(output_unit->getOutQueue(), this);
     out_link->setVcsPerVnet(consumerVcs);
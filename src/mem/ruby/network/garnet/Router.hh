@@ -36,6 +36,7 @@
 #include <memory>
 #include <vector>
 
+#include "enums/GarnetSwitchAllocator.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/BasicRouter.hh"
@@ -125,7 +126,7 @@ class Router : public BasicRouter, public Consumer
     void printAggregateFaultProbability(std::ostream& out);
 
     void regStats();
-    void collateStats();
+    virtual void collateStats();
     void resetStats();
 
     // For Fault Model:
@@ -154,6 +155,12 @@ class Router : public BasicRouter, public Consumer
     std::vector<std::shared_ptr<InputUnit>> m_input_unit;
     std::vector<std::shared_ptr<OutputUnit>> m_output_unit;
 
+    // Ports with work, one bit per port. A flit arriving on an inport
+    // link or a credit arriving on an outport credit link sets the bit,
+    // and wakeup clears it once the link is drained.
+    uint64_t m_active_inports;
+    uint64_t m_active_outports;
+
     // Statistical variables required for power computations
     statistics::Scalar m_buffer_reads;
     statistics::Scalar m_buffer_writes;
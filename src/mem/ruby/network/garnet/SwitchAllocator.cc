@@ -31,6 +31,7 @@
 
 #include "mem/ruby/network/garnet/SwitchAllocator.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "debug/RubyNetworkPacket.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
@@ -56,6 +57,9 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_age_arbitration = false;
+    m_bitset_allocation = false;
+    m_requested_outports = 0;
 }
 
 void
@@ -64,6 +68,7 @@ SwitchAllocator::init()
     m_num_inports = m_router->get_num_inports();
     m_num_outports = m_router->get_num_outports();
     m_round_robin_inport.resize(m_num_outports);
+    m_outport_requestors.assign(m_num_outports, 0);
     m_round_robin_invc.resize(m_num_inports);
     m_port_requests.resize(m_num_inports);
     m_vc_winners.resize(m_num_inports);
@@ -91,15 +96,20 @@ SwitchAllocator::init()
 void
 SwitchAllocator::wakeup()
 {
-    arbitrate_inports(); // First stage of allocation
-    arbitrate_outports(); // Second stage of allocation
+    if (m_bitset_allocation) {
+        arbitrate_inports_bitset();
+        arbitrate_outports_bitset();
+    } else {
+        arbitrate_inports(); // First stage of allocation
+        arbitrate_outports(); // Second stage of allocation
+    }
 
     clear_request_vector();
     check_for_wakeup();
 }
 
 /*
- * SA-I (or SA-i) loops through all input VCs at every input port,
+ * SA-I (or SA-i) loops through the busy input VCs at every input port,
  * and selects one in a round robin manner.
  *    - For HEAD/HEAD_TAIL flits only selects an input VC whose output port
  *     has at least one free output VC.
@@ -114,14 +124,23 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
+        auto input_unit = m_router->getInputUnit(inport);
+        uint64_t busy_vcs = input_unit->get_busy_vcs();
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        // Visit the busy VCs from the round robin pointer onwards,
+        // then wrap around to the ones below it.
+        uint64_t from_pointer =
+            busy_vcs & (~0ULL << m_round_robin_invc[inport]);
+        uint64_t vcs_in_order[2] = {from_pointer, busy_vcs & ~from_pointer};
 
-            if (input_unit->need_stage(invc, SA_, curTick())) {
-                // This flit is in SA stage
+        for (uint64_t vcs : vcs_in_order) {
+            for (; vcs && m_port_requests[inport] == -1; vcs &= vcs - 1) {
+                int invc = findLsbSet(vcs);
+
+                if (!input_unit->need_stage(invc, SA_, curTick()))
+                    continue;
 
+                // This flit is in SA stage
                 int outport = input_unit->get_outport(invc);
                 int outvc = input_unit->get_outvc(invc);
 
@@ -134,14 +153,9 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
                     m_vc_winners[inport] = invc;
-
-                    break; // got one vc winner for this port
+                    m_requested_outports |= 1ULL << outport;
                 }
             }
-
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
         }
     }
 }
@@ -165,115 +179,192 @@ SwitchAllocator::arbitrate_outports()
 {
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
-    // Independent arbiter at each output port
-    for (int outport = 0; outport < m_num_outports; outport++) {
-        int inport = m_round_robin_inport[outport];
+    // Independent arbiter at each requested output port
+    for (uint64_t outports = m_requested_outports; outports;
+         outports &= outports - 1) {
+        int outport = findLsbSet(outports);
+        int inport = m_age_arbitration ? oldest_requestor(outport)
+                                       : m_round_robin_inport[outport];
 
         for (int inport_iter = 0; inport_iter < m_num_inports;
                  inport_iter++) {
 
             // inport has a request this cycle for outport
             if (m_port_requests[inport] == outport) {
-                auto output_unit = m_router->getOutputUnit(outport);
-                auto input_unit = m_router->getInputUnit(inport);
+                grant_outport(outport, inport);
+                break; // got a input winner for this outport
+            }
 
-                // grant this outport to this inport
-                int invc = m_vc_winners[inport];
+            inport++;
+            if (inport >= m_num_inports)
+                inport = 0;
+        }
+    }
+}
 
-                int outvc = input_unit->get_outvc(invc);
-                if (outvc == -1) {
-                    // VC Allocation - select any free VC from outport
-                    outvc = vc_allocate(outport, inport, invc);
-                }
+// Grant outport to the SA-I winner of inport and send the flit
+// to the crossbar.
+void
+SwitchAllocator::grant_outport(int outport, int inport)
+{
+    auto output_unit = m_router->getOutputUnit(outport);
+    auto input_unit = m_router->getInputUnit(inport);
 
-                // remove flit from Input VC
-                flit *t_flit = input_unit->getTopFlit(invc);
-
-                DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
-                                     "granted outvc %d at outport %d "
-                                     "to invc %d at inport %d to flit %s at "
-                                     "cycle: %lld\n",
-                        m_router->get_id(), outvc,
-                        m_router->getPortDirectionName(
-                            output_unit->get_direction()),
-                        invc,
-                        m_router->getPortDirectionName(
-                            input_unit->get_direction()),
-                            *t_flit,
-                        m_router->curCycle());
-                NDPRINTF(RubyNetworkPacket,
-                        t_flit, m_router->get_net_ptr()->get_trace_packet_id(),
-                        "Router[%d] SA granted outvc %d at outport %d(%d) "
-                        " to invc %d at inport %d(%d) to flit %s\n",
-                        t_flit->get_cur_router(),
-                        outvc, m_router->getPortDirectionName(
-                            output_unit->get_direction()), outport,
-                        invc, m_router->getPortDirectionName(
-                            input_unit->get_direction()),
-                        inport, *t_flit);
-
-
-                // Update outport field in the flit since this is
-                // used by CrossbarSwitch code to send it out of
-                // correct outport.
-                // Note: post route compute in InputUnit,
-                // outport is updated in VC, but not in flit
-                t_flit->set_outport(outport);
-
-                // set outvc (i.e., invc for next hop) in flit
-                // (This was updated in VC by vc_allocate, but not in flit)
-                t_flit->set_vc(outvc);
-
-                // decrement credit in outvc
-                output_unit->decrement_credit(outvc);
-
-                // flit ready for Switch Traversal
-                t_flit->advance_stage(ST_, curTick());
-                m_router->grant_switch(inport, t_flit);
-                m_output_arbiter_activity++;
-
-                if ((t_flit->get_type() == TAIL_) ||
-                    t_flit->get_type() == HEAD_TAIL_) {
-
-                    // This Input VC should now be empty
-                    assert(!(input_unit->isReady(invc, curTick())));
-
-                    // Free this VC
-                    input_unit->set_vc_idle(invc, curTick());
-
-                    // Send a credit back
-                    // along with the information that this VC is now idle
-                    input_unit->increment_credit(invc, true, curTick());
-                } else {
-                    // Send a credit back
-                    // but do not indicate that the VC is idle
-                    input_unit->increment_credit(invc, false, curTick());
-                }
+    // grant this outport to this inport
+    int invc = m_vc_winners[inport];
 
-                // remove this request
-                m_port_requests[inport] = -1;
+    int outvc = input_unit->get_outvc(invc);
+    if (outvc == -1) {
+        // VC Allocation - select any free VC from outport
+        outvc = vc_allocate(outport, inport, invc);
+    }
 
-                // Update Round Robin pointer
-                m_round_robin_inport[outport] = inport + 1;
-                if (m_round_robin_inport[outport] >= m_num_inports)
-                    m_round_robin_inport[outport] = 0;
+    // remove flit from Input VC
+    flit *t_flit = input_unit->getTopFlit(invc);
+
+    DPRINTF(RubyNetwork, "SwitchAllocator at Router %d "
+                         "granted outvc %d at outport %d "
+                         "to invc %d at inport %d to flit %s at "
+                         "cycle: %lld\n",
+            m_router->get_id(), outvc,
+            m_router->getPortDirectionName(
+                output_unit->get_direction()),
+            invc,
+            m_router->getPortDirectionName(
+                input_unit->get_direction()),
+                *t_flit,
+            m_router->curCycle());
+    NDPRINTF(RubyNetworkPacket,
+            t_flit, m_router->get_net_ptr()->get_trace_packet_id(),
+            "Router[%d] SA granted outvc %d at outport %d(%d) "
+            " to invc %d at inport %d(%d) to flit %s\n",
+            t_flit->get_cur_router(),
+            outvc, m_router->getPortDirectionName(
+                output_unit->get_direction()), outport,
+            invc, m_router->getPortDirectionName(
+                input_unit->get_direction()),
+            inport, *t_flit);
+
+
+    // Update outport field in the flit since this is
+    // used by CrossbarSwitch code to send it out of
+    // correct outport.
+    // Note: post route compute in InputUnit,
+    // outport is updated in VC, but not in flit
+    t_flit->set_outport(outport);
+
+    // set outvc (i.e., invc for next hop) in flit
+    // (This was updated in VC by vc_allocate, but not in flit)
+    t_flit->set_vc(outvc);
+
+    // decrement credit in outvc
+    output_unit->decrement_credit(outvc);
+
+    // flit ready for Switch Traversal
+    t_flit->advance_stage(ST_, curTick());
+    m_router->grant_switch(inport, t_flit);
+    m_output_arbiter_activity++;
+
+    if ((t_flit->get_type() == TAIL_) ||
+        t_flit->get_type() == HEAD_TAIL_) {
+
+        // This Input VC should now be empty
+        assert(!(input_unit->isReady(invc, curTick())));
+
+        // Free this VC
+        input_unit->set_vc_idle(invc, curTick());
+
+        // Send a credit back
+        // along with the information that this VC is now idle
+        input_unit->increment_credit(invc, true, curTick());
+    } else {
+        // Send a credit back
+        // but do not indicate that the VC is idle
+        input_unit->increment_credit(invc, false, curTick());
+    }
 
-                // Update Round Robin pointer to the next VC
-                // We do it here to keep it fair.
-                // Only the VC which got switch traversal
-                // is updated.
-                m_round_robin_invc[inport] = invc + 1;
-                if (m_round_robin_invc[inport] >= m_num_vcs)
-                    m_round_robin_invc[inport] = 0;
+    // remove this request
+    m_port_requests[inport] = -1;
+
+    // Update Round Robin pointer
+    m_round_robin_inport[outport] = inport + 1;
+    if (m_round_robin_inport[outport] >= m_num_inports)
+        m_round_robin_inport[outport] = 0;
+
+    // Update Round Robin pointer to the next VC
+    // We do it here to keep it fair.
+    // Only the VC which got switch traversal
+    // is updated.
+    m_round_robin_invc[inport] = invc + 1;
+    if (m_round_robin_invc[inport] >= m_num_vcs)
+        m_round_robin_invc[inport] = 0;
+}
 
+// Lowest set bit at or above start, wrapping around to the lowest
+// set bit overall. bits must be non-zero.
+static inline int
+first_from(uint64_t bits, int start)
+{
+    uint64_t upper = bits & (~0ULL << start);
+    return findLsbSet(upper ? upper : bits);
+}
 
-                break; // got a input winner for this outport
-            }
+/*
+ * SA-I of the bitset allocator. The SA-ready VCs of an inport are
+ * gathered into a mask, and the first one at or after the round robin
+ * pointer that may send wins, as in arbitrate_inports(). The request
+ * is recorded in the inport mask of its outport.
+ */
 
-            inport++;
-            if (inport >= m_num_inports)
-                inport = 0;
+void
+SwitchAllocator::arbitrate_inports_bitset()
+{
+    for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+
+        uint64_t ready_vcs = 0;
+        for (uint64_t vcs = input_unit->get_busy_vcs(); vcs;
+             vcs &= vcs - 1) {
+            int invc = findLsbSet(vcs);
+            if (input_unit->need_stage(invc, SA_, curTick()))
+                ready_vcs |= 1ULL << invc;
         }
+
+        while (ready_vcs) {
+            int invc = first_from(ready_vcs, m_round_robin_invc[inport]);
+            int outport = input_unit->get_outport(invc);
+            int outvc = input_unit->get_outvc(invc);
+
+            if (request_allowed(inport, invc, outport, outvc)) {
+                m_input_arbiter_activity++;
+                m_port_requests[inport] = outport;
+                m_vc_winners[inport] = invc;
+                m_outport_requestors[outport] |= 1ULL << inport;
+                m_requested_outports |= 1ULL << outport;
+                break;
+            }
+            ready_vcs &= ~(1ULL << invc);
+        }
+    }
+}
+
+/*
+ * SA-II of the bitset allocator. Each requested outport goes to the
+ * first inport of its request mask at or after the round robin pointer,
+ * or to the oldest requestor under age arbitration.
+ */
+
+void
+SwitchAllocator::arbitrate_outports_bitset()
+{
+    for (uint64_t outports = m_requested_outports; outports;
+         outports &= outports - 1) {
+        int outport = findLsbSet(outports);
+        int inport = m_age_arbitration ? oldest_requestor(outport) :
+            first_from(m_outport_requestors[outport],
+                       m_round_robin_inport[outport]);
+
+        grant_outport(outport, inport);
     }
 }
 
@@ -348,6 +439,25 @@ SwitchAllocator::send_allowed(int inport, int invc, int outport, int outvc)
     return true;
 }
 
+// send_allowed() on the output VC masks of the outport. Only ordered
+// vnets go on to the per-VC ordering check.
+bool
+SwitchAllocator::request_allowed(int inport, int invc, int outport, int outvc)
+{
+    auto output_unit = m_router->getOutputUnit(outport);
+    int vnet = get_vnet(invc);
+
+    uint64_t outvcs = (outvc == -1) ? output_unit->get_free_vcs(vnet) :
+        output_unit->get_credit_vcs() & (1ULL << outvc);
+    if (!outvcs)
+        return false;
+
+    if ((m_router->get_net_ptr())->isVNetOrdered(vnet))
+        return send_allowed(inport, invc, outport, outvc);
+
+    return true;
+}
+
 // Assign a free VC to the winner of the output port.
 int
 SwitchAllocator::vc_allocate(int outport, int inport, int invc)
@@ -362,6 +472,32 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
     return outvc;
 }
 
+// Find the inport whose SA-I winner for this outport was injected
+// earliest. Ties go to the inport closest to the round-robin pointer.
+int
+SwitchAllocator::oldest_requestor(int outport)
+{
+    int winner = m_round_robin_inport[outport];
+    Tick oldest = MaxTick;
+
+    int inport = m_round_robin_inport[outport];
+    for (int inport_iter = 0; inport_iter < m_num_inports; inport_iter++) {
+        if (m_port_requests[inport] == outport) {
+            flit *t_flit = m_router->getInputUnit(inport)->
+                peekTopFlit(m_vc_winners[inport]);
+            if (t_flit->get_enqueue_time() < oldest) {
+                oldest = t_flit->get_enqueue_time();
+                winner = inport;
+            }
+        }
+
+        inport++;
+        if (inport >= m_num_inports)
+            inport = 0;
+    }
+    return winner;
+}
+
 // Wakeup the router next cycle to perform SA again
 // if there are flits ready.
 void
@@ -374,8 +510,10 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+        auto input_unit = m_router->getInputUnit(i);
+        for (uint64_t vcs = input_unit->get_busy_vcs(); vcs;
+             vcs &= vcs - 1) {
+            if (input_unit->need_stage(findLsbSet(vcs), SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -398,6 +536,11 @@ void
 SwitchAllocator::clear_request_vector()
 {
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    for (uint64_t outports = m_requested_outports; outports;
+         outports &= outports - 1) {
+        m_outport_requestors[findLsbSet(outports)] = 0;
+    }
+    m_requested_outports = 0;
 }
 
 void
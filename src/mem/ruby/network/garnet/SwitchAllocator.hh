@@ -63,8 +63,21 @@ class SwitchAllocator : public Consumer
     void print(std::ostream& out) const {};
     void arbitrate_inports();
     void arbitrate_outports();
+    void arbitrate_inports_bitset();
+    void arbitrate_outports_bitset();
+    void grant_outport(int outport, int inport);
     bool send_allowed(int inport, int invc, int outport, int outvc);
+    bool request_allowed(int inport, int invc, int outport, int outvc);
     int vc_allocate(int outport, int inport, int invc);
+    int oldest_requestor(int outport);
+
+    // Grant each outport to its oldest requesting flit instead of
+    // rotating a round-robin pointer over the inports.
+    void set_age_arbitration(bool age) { m_age_arbitration = age; }
+
+    // Keep the SA requests as per-outport inport masks and pick the
+    // round-robin winners from them, instead of scanning every port.
+    void set_bitset_allocation(bool bitset) { m_bitset_allocation = bitset; }
 
     inline double
     get_input_arbiter_activity()
@@ -84,12 +97,18 @@ class SwitchAllocator : public Consumer
     int m_num_vcs, m_vc_per_vnet;
 
     double m_input_arbiter_activity, m_output_arbiter_activity;
+    bool m_age_arbitration;
+    bool m_bitset_allocation;
 
     Router *m_router;
     std::vector<int> m_round_robin_invc;
     std::vector<int> m_round_robin_inport;
     std::vector<int> m_port_requests;
     std::vector<int> m_vc_winners;
+    // Outports requested in SA-I this cycle, one bit per outport
+    uint64_t m_requested_outports;
+    // Inports requesting each outport this cycle (bitset allocator only)
+    std::vector<uint64_t> m_outport_requestors;
 };
 
 } // namespace garnet
@@ -30,6 +30,8 @@
 
 #include "mem/ruby/network/garnet/flit.hh"
 
+#include <vector>
+
 #include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
 
@@ -42,6 +44,69 @@ namespace ruby
 namespace garnet
 {
 
+namespace
+{
+
+// Most blocks a thread keeps per size. With partitions, flits are often
+// freed on another thread than the one that allocated them. Past the
+// cap those go back to the heap instead of piling up on the freeing
+// thread.
+constexpr std::size_t maxFreeFlits = 4096;
+
+// Free blocks indexed by their size in units of max_align_t. Flit,
+// Credit and RPMFlit each land in their own list. The blocks are
+// returned to the heap when the thread exits.
+struct FlitFreeLists
+{
+    std::vector<std::vector<void *>> buckets;
+
+    ~FlitFreeLists()
+    {
+        for (auto &bucket : buckets) {
+            for (void *ptr : bucket)
+                ::operator delete(ptr);
+        }
+    }
+};
+
+thread_local FlitFreeLists flitFreeLists;
+
+std::size_t
+flitPoolBucket(std::size_t size)
+{
+    return divCeil(size, alignof(std::max_align_t));
+}
+
+} // anonymous namespace
+
+void *
+flit::operator new(std::size_t size)
+{
+    std::size_t bucket = flitPoolBucket(size);
+    auto &buckets = flitFreeLists.buckets;
+    if (bucket < buckets.size() && !buckets[bucket].empty()) {
+        void *ptr = buckets[bucket].back();
+        buckets[bucket].pop_back();
+        return ptr;
+    }
+    return ::operator new(bucket * alignof(std::max_align_t));
+}
+
+void
+flit::operator delete(void *ptr, std::size_t size)
+{
+    std::size_t bucket = flitPoolBucket(size);
+    auto &buckets = flitFreeLists.buckets;
+    if (bucket >= buckets.size()) {
+        buckets.resize(bucket + 1);
+    }
+    if (buckets[bucket].size() >= maxFreeFlits) {
+        ::operator delete(ptr);
+        return;
+    }
+    buckets[bucket].push_back(ptr);
+}
+
 // Constructor for the flit
 flit::flit(int packet_id, int id, int  vc, int vnet, RouteInfo route, int size,
     MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime, int cur_router)
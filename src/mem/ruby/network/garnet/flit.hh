@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLIT_HH__
 
 #include <cassert>
+#include <cstddef>
 #include <iostream>
 
 #include "base/types.hh"
@@ -57,6 +58,12 @@ class flit
 
     virtual ~flit(){};
 
+    // Flits and credits are created and destroyed at every hop. Their
+    // storage is recycled through bounded per-thread, per-size free
+    // lists instead of going back to the heap.
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -33,7 +33,10 @@
 
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
+#include "mem/ruby/common/Set.hh"
 #include "mem/ruby/network/garnet/rpm/RPMFlit.hh"
 
 namespace gem5
@@ -60,15 +63,19 @@ enum Partition
     UNKNOWN_PARTITION   = 10
 };
 
-typedef std::map<int, std::set<int>> outport2dests_t;
+// Destination routers reached through each outport, one bit per router.
+// Entries are sorted by outport.
+typedef std::vector<std::pair<int, Set>> outport2dests_t;
 
 struct ReplicaInfo
 {
     ReplicaInfo(int _inport, int _outport, RPMFlit* _rpmFlit)
-        : inport(_inport), outport(_outport), rpmFlit(_rpmFlit) {}
+        : inport(_inport), outport(_outport), rpmFlit(_rpmFlit),
+          insertCycle(0) {}
     int inport;
     int outport;
     RPMFlit* rpmFlit;
+    Cycles insertCycle; // when the replica entered a set-aside buffer
 };
 
 } // namespace garnet
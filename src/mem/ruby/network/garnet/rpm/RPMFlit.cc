@@ -52,28 +52,23 @@ RPMFlit::RPMFlit(int packet_id, int id,
 {}
 
 RPMFlit*
-RPMFlit::replicate(GarnetNetwork *net_ptr, std::set<int> dest_routers)
+RPMFlit::replicate(GarnetNetwork *net_ptr, const Set &dest_routers)
 {
     //FIXME: Here we need to update vnet in flit if it goes to north
     // and the current router is source. For now I couldn't found the
     // deadlock issue yet...
-    RPMFlit* f = new RPMFlit();
-    *f = *this; // it is okay because there is not pointer.
-    f->m_msg_ptr = f->m_msg_ptr->clone();
+    // Replicas share the message. The destination NI copies it on
+    // ejection if another replica still holds it. The rest of the route
+    // is a handful of ints next to net_dest, which is the fixed-width
+    // destination bitmask of this replica. Copying them with the pooled
+    // flit is cheaper than sharing them through a counted pointer.
+    RPMFlit* f = new RPMFlit(*this);
 
-    std::vector<NodeID> all_dest = m_route.net_dest.getAllDest();
-    std::set<int> dest_nis;
-    for (auto dest_ni_id : all_dest) {
-        int dest_router_id = net_ptr->get_router_id(dest_ni_id, f->m_vnet);
-        if (dest_routers.find(dest_router_id) != dest_routers.end()) {
-            dest_nis.insert(dest_ni_id);
-        } else {
-            f->m_route.dest_nis.erase(dest_ni_id);
-            f->m_route.dest_routers.erase(dest_router_id);
-        }
-    }
-
-    f->m_route.net_dest.removeDestsExcept(dest_nis);
+    int vnet = m_vnet;
+    f->m_route.net_dest.removeDestsIf([&](NodeID dest_ni_id) {
+        return !dest_routers.isElement(
+                net_ptr->get_router_id(dest_ni_id, vnet));
+    });
     return f;
 }
 
@@ -92,16 +87,10 @@ RPMFlit::print(std::ostream& out) const
     out << "Dest NI=" << m_route.dest_ni << " ";
     out << "Dest Router=" << m_route.dest_router << " ";
     std::string ss = "";
-    for (auto dest_ni : m_route.dest_nis) {
+    for (auto dest_ni : m_route.net_dest) {
         ss += std::to_string(dest_ni) + " ";
     }
     out << "Dest NIS=" << ss << " ";
-
-    ss = "";
-    for (auto dest_router : m_route.dest_routers) {
-        ss += std::to_string(dest_router) + " ";
-    }
-    out << "Dest Routers=" << ss << " ";
     out << "Set Time=" << m_time << " ";
     out << "Width=" << m_width<< " ";
     out << "Cur Router=" << m_cur_router << " ";
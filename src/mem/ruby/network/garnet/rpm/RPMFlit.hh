@@ -31,6 +31,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_RPM_FLIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_RPM_FLIT_HH__
 
+#include "mem/ruby/common/Set.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet/flit.hh"
 
@@ -55,7 +56,7 @@ class RPMFlit : public flit
         ~RPMFlit() = default;
 
         RPMFlit* replicate(GarnetNetwork* net_ptr,
-                std::set<int> dest_routers);
+                const Set &dest_routers);
 
         void print(std::ostream& out) const;
 };
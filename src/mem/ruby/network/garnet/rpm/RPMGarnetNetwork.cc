@@ -43,7 +43,8 @@ namespace garnet
 
 RPMGarnetNetwork::RPMGarnetNetwork(const Params &p)
     : GarnetNetwork(p),
-    deadlockCheckEvent([this]{ wakeup(); }, "RPMGarnetNetwork multicast check")
+    deadlockCheckEvent([this]{ wakeup(); }, "RPMGarnetNetwork multicast check"),
+    m_multicast_routing(p.multicast_routing)
 {
 }
 
@@ -54,6 +55,7 @@ RPMGarnetNetwork::init()
     m_multicast_threshold = Cycles(5000000);
 }
 
+// Called from flitisizeMessage(), which holds lockShared()
 void
 RPMGarnetNetwork::add_multicast_packet(
         const int packet_id, Cycles inj_time, std::set<int> dests)
@@ -74,6 +76,7 @@ void
 RPMGarnetNetwork::remove_multicast_dest(const int packet_id,
             const int dest)
 {
+    auto lock = lockShared();
     assert(m_multicast_table.find(packet_id) != m_multicast_table.end());
     std::pair<Cycles, std::set<int>> cNd = m_multicast_table[packet_id];
     assert(cNd.second.find(dest) != cNd.second.end());
@@ -88,6 +91,7 @@ RPMGarnetNetwork::remove_multicast_dest(const int packet_id,
 void
 RPMGarnetNetwork::wakeup()
 {
+    auto lock = lockShared();
     Cycles current_time = curCycle();
     for (auto p2cNd : m_multicast_table) {
         int packet_id = p2cNd.first;
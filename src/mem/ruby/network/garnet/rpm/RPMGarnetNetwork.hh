@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_RPM_GARNETNETWORK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_RPM_GARNETNETWORK_HH__
 
+#include "enums/MulticastRouting.hh"
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "params/RPMGarnetNetwork.hh"
 
@@ -47,12 +48,15 @@ namespace garnet
 class RPMGarnetNetwork : public GarnetNetwork
 {
     public:
-        typedef GarnetNetworkParams Params;
+        typedef RPMGarnetNetworkParams Params;
         RPMGarnetNetwork(const Params &p);
         ~RPMGarnetNetwork() = default;
 
         void init();
 
+        enums::MulticastRouting getMulticastRouting() const
+        { return m_multicast_routing; }
+
         // For deack lock detection
         void add_multicast_packet(
                 const int packet_id, Cycles inj_time, std::set<int> dests);
@@ -62,6 +66,7 @@ class RPMGarnetNetwork : public GarnetNetwork
         std::string get_multicast_status();
         EventFunctionWrapper deadlockCheckEvent;
     private:
+        enums::MulticastRouting m_multicast_routing;
         Cycles m_multicast_threshold;
         std::map<int, std::pair<Cycles, std::set<int>>> m_multicast_table;
 };
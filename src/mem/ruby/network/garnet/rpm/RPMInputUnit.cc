@@ -57,6 +57,18 @@ RPMInputUnit::wakeup()
     flit *t_flit;
     if (m_in_link->isReady(curTick())) {
 
+        // All replicas but the one kept in the VC go to the set-aside
+        // buffer. Leave the flit on the link, holding the upstream
+        // credit, until the buffer has room for them.
+        t_flit = m_in_link->peekLink();
+        outport2dests_t outport2dests = m_rpm_router->route_compute(
+                t_flit->get_route(), m_direction);
+        if (!getSetAsideBuffer()->has_credits(outport2dests.size() - 1)) {
+            getSetAsideBuffer()->record_stall();
+            m_router->schedule_wakeup(Cycles(1));
+            return;
+        }
+
         t_flit = m_in_link->consumeLink();
         DPRINTF(RubyNetwork, "Router[%d] Consuming:%s Width: %d Flit:%s\n",
         m_router->get_id(), m_in_link->name(),
@@ -70,13 +82,11 @@ RPMInputUnit::wakeup()
         int vc = t_flit->get_vc();
         t_flit->increment_hops(); // for stats
 
-        outport2dests_t outport2dests = m_rpm_router->route_compute(
-                t_flit->get_route(), m_direction);
-
         RPMFlit* t_rpmflit = dynamic_cast<RPMFlit*>(t_flit);
         assert(t_rpmflit != nullptr);
-        std::vector<ReplicaInfo> replicas;
-        for (auto o2dests: outport2dests) {
+        std::vector<ReplicaInfo> &replicas = m_replicas;
+        replicas.clear();
+        for (auto &o2dests: outport2dests) {
             int outport = o2dests.first;
             RPMFlit* f = t_rpmflit->replicate(
                     m_router->get_net_ptr(), o2dests.second);
@@ -133,7 +143,7 @@ RPMInputUnit::wakeup()
                 t_flit->get_cur_router(), m_direction, m_id, vc, *t_flit);
         virtualChannels[vc].insertFlit(t_flit);
 
-        for (auto replica : replicas) {
+        for (const auto &replica : replicas) {
             NDPRINTF(RubyNetworkPacket, t_flit,
                     m_router->get_net_ptr()->get_trace_packet_id(),
                     "Router[%d] IN[%s(%d)] "
@@ -172,16 +182,24 @@ RPMInputUnit::wakeup()
     }
 }
 
-void
-RPMInputUnit::insertReplicas(const int inport,
-        std::vector<ReplicaInfo> replicas)
+RPMSetAsideBuffer*
+RPMInputUnit::getSetAsideBuffer()
 {
-    int selected_setaside_id = m_rpm_router->selectSetAsideBuffer(inport);
+    int selected_setaside_id = m_rpm_router->selectSetAsideBuffer(m_id);
     auto input_unit = m_rpm_router->getInputUnit(selected_setaside_id);
 
     RPMSetAsideBuffer* rpm_buffer
         = dynamic_cast<RPMSetAsideBuffer*>(input_unit);
-    rpm_buffer->insertReplicas(replicas);
+    assert(rpm_buffer != nullptr);
+    return rpm_buffer;
+}
+
+void
+RPMInputUnit::insertReplicas(const int inport,
+        const std::vector<ReplicaInfo> &replicas)
+{
+    assert(inport == m_id);
+    getSetAsideBuffer()->insertReplicas(replicas);
 }
 
 } // namespace garnet
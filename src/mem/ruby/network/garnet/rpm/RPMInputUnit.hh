@@ -46,6 +46,8 @@ namespace ruby
 namespace garnet
 {
 
+class RPMSetAsideBuffer;
+
 class RPMInputUnit : public InputUnit
 {
     public:
@@ -55,11 +57,15 @@ class RPMInputUnit : public InputUnit
         void wakeup();
 
         void insertReplicas(
-
-                const int inport, std::vector<ReplicaInfo> replicas);
+                const int inport, const std::vector<ReplicaInfo> &replicas);
 
     private:
+        RPMSetAsideBuffer* getSetAsideBuffer();
+
         RPMRouter* m_rpm_router;
+
+        // Reused for the replicas of each flit to avoid reallocating
+        std::vector<ReplicaInfo> m_replicas;
 };
 
 } // namespace garnet
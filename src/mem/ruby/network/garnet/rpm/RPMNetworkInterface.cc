@@ -52,7 +52,8 @@ namespace garnet
 {
 
 RPMNetworkInterface::RPMNetworkInterface(const Params &p)
-    : NetworkInterface(p), m_rpm_net_ptr(nullptr) {}
+    : NetworkInterface(p), m_rpm_net_ptr(nullptr),
+      m_partial_msg_sent(m_virtual_networks) {}
 
 void
 RPMNetworkInterface::init_net_ptr(GarnetNetwork *net_ptr)
@@ -130,7 +131,8 @@ RPMNetworkInterface::wakeup()
                 if (!iPort->messageEnqueuedThisCycle &&
                     outNode_ptr[vnet]->areNSlotsAvailable(1, curTime)) {
                     // Space is available. Enqueue to protocol buffer.
-                    outNode_ptr[vnet]->enqueue(t_flit->get_msg_ptr(), curTime,
+                    outNode_ptr[vnet]->enqueue(ejectedMessage(t_flit),
+                                               curTime,
                                                cyclesToTicks(Cycles(1)));
 
                     // Simply send a credit back since we are not buffering
@@ -224,7 +226,7 @@ RPMNetworkInterface::checkStallQueue()
                 // send back credits
                 if (outNode_ptr[vnet]->areNSlotsAvailable(1,
                     curTime)) {
-                    outNode_ptr[vnet]->enqueue(stallFlit->get_msg_ptr(),
+                    outNode_ptr[vnet]->enqueue(ejectedMessage(stallFlit),
                         curTime, cyclesToTicks(Cycles(1)));
 
                     // Send back a credit with free signal now that the
@@ -269,6 +271,19 @@ RPMNetworkInterface::checkStallQueue()
     }
 }
 
+// Replicas of a multicast share one message, but enqueueing stamps
+// timing into it. Hand out a copy while another replica or an earlier
+// ejection still holds the message.
+MsgPtr
+RPMNetworkInterface::ejectedMessage(flit *t_flit)
+{
+    MsgPtr &msg_ptr = t_flit->get_msg_ptr();
+    if (msg_ptr.use_count() > 1) {
+        return msg_ptr->clone();
+    }
+    return msg_ptr;
+}
+
 int
 RPMNetworkInterface::calculateVC(int vnet)
 {
@@ -304,12 +319,14 @@ RPMNetworkInterface::calculateVC(int vnet)
 bool
 RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
 {
+    if (m_rpm_net_ptr->getMulticastRouting() == enums::unicast) {
+        return flitisizeUnicast(msg_ptr, vnet);
+    }
+
+    auto lock = m_rpm_net_ptr->lockShared();
     Message *net_msg_ptr = msg_ptr.get();
     NetDest net_msg_dest = net_msg_ptr->getDestination();
 
-    // gets all the destinations associated with this message.
-    std::vector<NodeID> dest_nodes = net_msg_dest.getAllDest();
-
     // Number of flits is dependent on the link bandwidth available.
     // This is expressed in terms of bytes/cycle or the flit size
     OutputPort *oPort = getOutportForVnet(vnet);
@@ -332,11 +349,8 @@ RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     route.src_router = oPort->routerID();
     route.dest_ni = -1;
     route.dest_router = -1;
-    for (auto destID: dest_nodes) {
-        route.dest_nis.insert(destID);
-        route.dest_routers.insert(m_rpm_net_ptr->get_router_id(destID, vnet));
-    }
     route.hops_traversed = -1;
+    route.pkt_class = GarnetNetwork::get_packet_class(net_msg_dest);
 
     //-----------------------------------------------------------
     // Compute outports to see if there is a packet going to North
@@ -364,9 +378,9 @@ RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
       (float)oPortNorth->bitWidth());
     assert(m_virtual_networks % 2 == 0
             && vnet < (m_virtual_networks / 2));
-    std::set<int> dest_routers_north;
+    Set dest_routers_north;
     for (auto o2dests : outport2dests) {
-      if (rpmRouter->isNorthPartition(o2dests.second)) {
+      if (rpmRouter->isUpperChannel(o2dests.second)) {
         outport_north = o2dests.first;
         dest_routers_north = o2dests.second;
         vc_north = calculateVC(vnet_north);
@@ -395,40 +409,43 @@ RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         if (vc_north == -1 || vc == -1) return false;
     }
 
-    // Create a route for North if there is an outport to north
+    // Create a route for North if there is an outport to north.
+    // The destination routers of each packet are only kept for the
+    // multicast deadlock check.
     RouteInfo route_north = route; // Use data in route
-    route_north.dest_nis.clear();
-    route_north.dest_routers.clear();
-    if (outport_north != -1) {
-        std::set<int> dest_nis_north;
-        assert(dest_routers_north.size() > 0);
-        for (auto dest_ni_id : dest_nodes) {
-            int dest_router_id
-                = m_rpm_net_ptr->get_router_id(dest_ni_id, vnet);
-            if (dest_routers_north.find(dest_router_id)
-                    != dest_routers_north.end()) {
-                dest_nis_north.insert(dest_ni_id);
-
-                route.dest_nis.erase(dest_ni_id);
-                route.dest_routers.erase(dest_router_id);
-
-                route_north.dest_nis.insert(dest_ni_id);
-                route_north.dest_routers.insert(dest_router_id);
-            }
+    std::set<int> check_dests;
+    std::set<int> check_dests_north;
+    for (auto dest_ni_id : net_msg_dest) {
+        int dest_router_id = m_rpm_net_ptr->get_router_id(dest_ni_id, vnet);
+        if (outport_north != -1 &&
+                dest_routers_north.isElement(dest_router_id)) {
+            check_dests_north.insert(dest_router_id);
+        } else {
+            check_dests.insert(dest_router_id);
         }
-        route.net_dest.removeDests(dest_nis_north);
-        route_north.net_dest.removeDestsExcept(dest_nis_north);
+    }
+    if (outport_north != -1) {
+        assert(!dest_routers_north.isEmpty());
+        route.net_dest.removeDestsIf([&](NodeID dest_ni_id) {
+            return dest_routers_north.isElement(
+                    m_rpm_net_ptr->get_router_id(dest_ni_id, vnet));
+        });
+        route_north.net_dest.removeDestsIf([&](NodeID dest_ni_id) {
+            return !dest_routers_north.isElement(
+                    m_rpm_net_ptr->get_router_id(dest_ni_id, vnet));
+        });
         m_rpm_net_ptr->increment_injected_packets(vnet_north);
     }
     m_rpm_net_ptr->increment_injected_packets(vnet);
+    m_rpm_net_ptr->increment_class_packets_injected(route.pkt_class);
 
     //-----------------------------------------------------------
     // Create flits that going to non-north outpots.
     //-----------------------------------------------------------
-    if (route.dest_routers.size() > 0) {
+    if (check_dests.size() > 0) {
         int packet_id = m_rpm_net_ptr->get_next_packet_id();
         m_rpm_net_ptr->add_multicast_packet(
-                packet_id, curCycle(), route.dest_routers);
+                packet_id, curCycle(), check_dests);
         // FIXME
         //m_rpm_net_ptr->update_traffic_distribution(route);
         MsgPtr new_msg_ptr = msg_ptr->clone();
@@ -456,7 +473,7 @@ RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     if (outport_north != -1) {
         int packet_id = m_rpm_net_ptr->get_next_packet_id();
         m_rpm_net_ptr->add_multicast_packet(
-                packet_id, curCycle(), route_north.dest_routers);
+                packet_id, curCycle(), check_dests_north);
         // FIXME
         //m_rpm_net_ptr->update_traffic_distribution(route_north);
         MsgPtr new_msg_ptr = msg_ptr->clone();
@@ -482,6 +499,86 @@ RPMNetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
     return true ;
 }
 
+// Baseline that sends a separate copy of the message to every
+// destination, as the plain NetworkInterface does.
+bool
+RPMNetworkInterface::flitisizeUnicast(MsgPtr msg_ptr, int vnet)
+{
+    auto lock = m_rpm_net_ptr->lockShared();
+    Message *net_msg_ptr = msg_ptr.get();
+    NetDest net_msg_dest = net_msg_ptr->getDestination();
+    NetDest &sent_dest = m_partial_msg_sent[vnet];
+
+    OutputPort *oPort = getOutportForVnet(vnet);
+    assert(oPort);
+    int num_flits = (int)divCeil((float) m_rpm_net_ptr->MessageSizeType_to_int(
+                net_msg_ptr->getMessageSize()), (float)oPort->bitWidth());
+
+    // As in the base NetworkInterface, the class is taken from the full
+    // destination set on the first attempt and remembered across retries.
+    packet_class pkt_class;
+    if (m_partial_msg_class[vnet] == -1) {
+        pkt_class = GarnetNetwork::get_packet_class(net_msg_dest);
+        m_rpm_net_ptr->increment_class_packets_injected(pkt_class);
+    } else {
+        pkt_class = (packet_class)m_partial_msg_class[vnet];
+    }
+    // Skip the copies sent before the last retry
+    net_msg_dest.removeNetDest(sent_dest);
+
+    for (auto dest_ni_id : net_msg_dest) {
+        int vc = calculateVC(vnet);
+        if (vc == -1) {
+            m_partial_msg_class[vnet] = pkt_class;
+            return false;
+        }
+
+        MsgPtr new_msg_ptr = msg_ptr->clone();
+        NetDest personal_dest = net_msg_dest;
+        personal_dest.removeDestsIf([&](NodeID id) {
+            return id != dest_ni_id;
+        });
+        new_msg_ptr->getDestination() = personal_dest;
+        // Record the destination, so a retry after running out of VCs
+        // does not send it twice.
+        sent_dest.addNetDest(personal_dest);
+
+        RouteInfo route;
+        route.vnet = vnet;
+        route.net_dest = personal_dest;
+        route.src_ni = m_id;
+        route.src_router = oPort->routerID();
+        route.dest_ni = dest_ni_id;
+        route.dest_router = m_rpm_net_ptr->get_router_id(dest_ni_id, vnet);
+        route.hops_traversed = -1;
+        route.pkt_class = pkt_class;
+
+        m_rpm_net_ptr->increment_injected_packets(vnet);
+        int packet_id = m_rpm_net_ptr->get_next_packet_id();
+        m_rpm_net_ptr->add_multicast_packet(packet_id, curCycle(),
+                std::set<int>{route.dest_router});
+        for (int i = 0; i < num_flits; i++) {
+            m_rpm_net_ptr->increment_injected_flits(vnet);
+            flit *fl = new RPMFlit(packet_id,
+                    i, vc, vnet, route, num_flits, new_msg_ptr,
+                    m_rpm_net_ptr->MessageSizeType_to_int(
+                        net_msg_ptr->getMessageSize()),
+                    oPort->bitWidth(), curTick(), oPort->routerID());
+
+            fl->set_src_delay(curTick() - msg_ptr->getTime());
+            niOutVcs[vc].insert(fl);
+            NDPRINTF(RubyNetworkPacket, fl, m_net_ptr->get_trace_packet_id(),
+                    "Router[%d] NI[%d] A flit is created %s\n",
+                    fl->get_cur_router(), m_id, *fl);
+        }
+        m_ni_out_vcs_enqueue_time[vc] = curTick();
+        outVcState[vc].setState(ACTIVE_, curTick());
+    }
+    m_partial_msg_class[vnet] = -1;
+    sent_dest.clear();
+    return true;
+}
+
 } // namespace garnet
 } // namespace ruby
 } // namespace gem5
@@ -32,6 +32,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_RPM_NETWORKINTERFACE_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_RPM_NETWORKINTERFACE_HH__
 
+#include <vector>
+
+#include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/garnet/NetworkInterface.hh"
 #include "mem/ruby/network/garnet/rpm/RPMGarnetNetwork.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -59,8 +62,15 @@ class RPMNetworkInterface : public NetworkInterface
         void checkStallQueue();
         int calculateVC(int vnet);
         bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
+        bool flitisizeUnicast(MsgPtr msg_ptr, int vnet);
+        MsgPtr ejectedMessage(flit *t_flit);
 
         RPMGarnetNetwork* m_rpm_net_ptr;
+
+        // Destinations of the message at the head of each vnet that the
+        // unicast baseline has already sent a copy to. The queued message
+        // itself is left untouched.
+        std::vector<NetDest> m_partial_msg_sent;
 };
 
 } // namespace garnet
@@ -32,6 +32,9 @@
 
 #include "mem/ruby/network/garnet/rpm/RPMRouter.hh"
 
+#include <algorithm>
+
+#include "base/logging.hh"
 #include "mem/ruby/network/garnet/rpm/RPMSetAsideBuffer.hh"
 
 namespace gem5
@@ -44,7 +47,9 @@ namespace garnet
 {
 
 RPMRouter::RPMRouter(const Params &p)
-    : Router(p), m_rpmRoutingUnit(nullptr)
+    : Router(p), m_rpmRoutingUnit(nullptr),
+      m_setaside_depth(p.setaside_depth),
+      m_setaside_arbitration(p.setaside_arbitration)
 {}
 
 void
@@ -57,16 +62,27 @@ RPMRouter::init()
     assert(m_rpmRoutingUnit != nullptr);
 
     // Add a set-aside buffer to the router
-    int port_id;
-    m_orig_num_inports = port_id = m_input_unit.size();
+    m_orig_num_inports = m_input_unit.size();
     m_num_setaside_buffers = m_input_unit.size();
     for (int i = 0; i < m_num_setaside_buffers; i++) {
-        port_id += i;
+        int port_id = m_orig_num_inports + i;
         m_input_unit.push_back(std::shared_ptr<InputUnit>(
-                    new RPMSetAsideBuffer(port_id, "RPM", this)));
+                    new RPMSetAsideBuffer(port_id, "RPM", this,
+                                          m_setaside_depth)));
         routingUnit->addInDirection("RPM", port_id);
     }
     Router::init();
+    m_rpmRoutingUnit->initRPMTables();
+
+    // A flit is split into at most one replica per outport, and all but
+    // one of them wait in the set-aside buffer.
+    fatal_if(m_setaside_depth < get_num_outports() - 1,
+             "Router %d: setaside_depth %d cannot hold the replicas of a "
+             "flit leaving through %d outports\n",
+             m_id, m_setaside_depth, get_num_outports());
+
+    switchAllocator.set_age_arbitration(
+            m_setaside_arbitration == enums::age);
 }
 
 outport2dests_t
@@ -94,11 +110,17 @@ RPMRouter::get_inport_dirn(const int inport)
 }
 
 bool
-RPMRouter::isNorthPartition(std::set<int> dests)
+RPMRouter::isNorthPartition(const Set &dests)
 {
     return m_rpmRoutingUnit->isNorthPartition(dests);
 }
 
+bool
+RPMRouter::isUpperChannel(const Set &dests)
+{
+    return m_rpmRoutingUnit->isUpperChannel(dests);
+}
+
 int RPMRouter::selectSetAsideBuffer(const int inport)
 {
     assert(inport < m_orig_num_inports);
@@ -107,6 +129,56 @@ int RPMRouter::selectSetAsideBuffer(const int inport)
     return selected_inport;
 }
 
+void
+RPMRouter::regStats()
+{
+    Router::regStats();
+
+    m_setaside_replicas
+        .name(name() + ".setaside_replicas")
+        .flags(statistics::nozero)
+    ;
+
+    m_setaside_wait_cycles
+        .name(name() + ".setaside_wait_cycles")
+        .flags(statistics::nozero)
+    ;
+
+    m_setaside_stall_cycles
+        .name(name() + ".setaside_stall_cycles")
+        .flags(statistics::nozero)
+    ;
+
+    m_setaside_max_occupancy
+        .name(name() + ".setaside_max_occupancy")
+        .flags(statistics::nozero)
+    ;
+
+    m_setaside_avg_wait
+        .name(name() + ".setaside_avg_wait")
+        .flags(statistics::nozero)
+    ;
+    m_setaside_avg_wait = m_setaside_wait_cycles / m_setaside_replicas;
+}
+
+void
+RPMRouter::collateStats()
+{
+    Router::collateStats();
+
+    int max_occupancy = 0;
+    for (int i = m_orig_num_inports; i < m_input_unit.size(); i++) {
+        auto rpm_buffer =
+            static_cast<RPMSetAsideBuffer*>(m_input_unit[i].get());
+        m_setaside_replicas += rpm_buffer->get_replicas();
+        m_setaside_wait_cycles += rpm_buffer->get_wait_cycles();
+        m_setaside_stall_cycles += rpm_buffer->get_stall_cycles();
+        max_occupancy = std::max(max_occupancy,
+                                 rpm_buffer->get_max_occupancy());
+    }
+    m_setaside_max_occupancy = max_occupancy;
+}
+
 } // namespace garnet
 } // namespace ruby
 } // namespace gem5
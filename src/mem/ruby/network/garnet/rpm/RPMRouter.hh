@@ -32,6 +32,8 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_RPM_ROUTER_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_RPM_ROUTER_HH__
 
+#include "base/statistics.hh"
+#include "enums/RPMSetAsideArbitration.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/network/garnet/rpm/RPMCommonTypes.hh"
 #include "mem/ruby/network/garnet/rpm/RPMFlit.hh"
@@ -50,7 +52,7 @@ namespace garnet
 class RPMRouter : public Router
 {
   public:
-    typedef GarnetRouterParams Params;
+    typedef RPMGarnetRouterParams Params;
     RPMRouter(const Params &p);
 
     ~RPMRouter() = default;
@@ -63,14 +65,27 @@ class RPMRouter : public Router
 
     PortDirection get_outport_dirn(const int outport);
     PortDirection get_inport_dirn(const int inport);
-    bool isNorthPartition(std::set<int> dests);
+    bool isNorthPartition(const Set &dests);
+    bool isUpperChannel(const Set &dests);
 
     int selectSetAsideBuffer(const int inport);
 
+    void regStats();
+    void collateStats();
+
   private:
     RPMRoutingUnit* m_rpmRoutingUnit;
     int m_num_setaside_buffers;
     int m_orig_num_inports;
+    int m_setaside_depth;
+    enums::RPMSetAsideArbitration m_setaside_arbitration;
+
+    // Statistical variables
+    statistics::Scalar m_setaside_replicas;
+    statistics::Scalar m_setaside_wait_cycles;
+    statistics::Scalar m_setaside_stall_cycles;
+    statistics::Scalar m_setaside_max_occupancy;
+    statistics::Formula m_setaside_avg_wait;
 };
 
 } // namespace garnet
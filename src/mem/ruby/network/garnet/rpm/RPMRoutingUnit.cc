@@ -30,8 +30,12 @@
 
 #include "mem/ruby/network/garnet/rpm/RPMRoutingUnit.hh"
 
+#include <cstdlib>
+
+#include "base/logging.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/Router.hh"
+#include "mem/ruby/network/garnet/rpm/RPMGarnetNetwork.hh"
 
 namespace gem5
 {
@@ -53,145 +57,261 @@ RPMRoutingUnit::outportComputeCustom(RouteInfo route,
     return outportComputeXY(route, inport, inport_dirn);
 }
 
-outport2dests_t
-RPMRoutingUnit::outportComputeRPM(RouteInfo route,
-                PortDirection inport_dirn)
+void
+RPMRoutingUnit::initRPMTables()
 {
-    // Step 1
-    // Collect all partitions of the destinations.
-    std::vector<NodeID> all_dest = route.net_dest.getAllDest();
-    std::vector<bool> dest_parts(NUM_PARTITION, false);
-    for (auto dest_ni_id : all_dest) {
-        int dest_router_id
-            = m_router->get_net_ptr()->get_router_id(dest_ni_id, route.vnet);
-        Partition p = getPartitionOf(dest_router_id);
-        dest_parts[p] = true;
+    auto rpm_net_ptr =
+        dynamic_cast<RPMGarnetNetwork*>(m_router->get_net_ptr());
+    assert(rpm_net_ptr != nullptr);
+    m_multicast_routing = rpm_net_ptr->getMulticastRouting();
+
+    int num_routers = m_router->get_net_ptr()->getNumRouters();
+    m_partition_of.resize(num_routers);
+    for (int dest_id = 0; dest_id < num_routers; dest_id++) {
+        m_partition_of[dest_id] = getPartitionOf(dest_id);
     }
 
-    // Step 2
-    // Calculate outports.
-    std::set<int> outports;
-    if (dest_parts[E_] ||
-            (dest_parts[SE_] && !dest_parts[S_] && !dest_parts[SW_])) {
-        outports.insert(m_outports_dirn2idx["East"]);
+    int outport_east  = lookupOutport("East");
+    int outport_west  = lookupOutport("West");
+    int outport_south = lookupOutport("South");
+    int outport_north = lookupOutport("North");
+    int outport_local = lookupOutport("Local");
+
+    m_partition_outport.resize(1 << NUM_PARTITION);
+    for (int mask = 0; mask < (1 << NUM_PARTITION); mask++) {
+        std::vector<bool> dest_parts(NUM_PARTITION, false);
+        for (int p = 0; p < NUM_PARTITION; p++) {
+            dest_parts[p] = (mask >> p) & 1;
+        }
+
+        // Outports used by a multicast whose destinations fall in
+        // these partitions.
+        bool east = dest_parts[E_] ||
+            (dest_parts[SE_] && !dest_parts[S_] && !dest_parts[SW_]);
+
+        bool north = dest_parts[N_]
+        || (dest_parts[NE_]
+                && (!dest_parts[E_] || (!dest_parts[SW_] && dest_parts[SE_])))
+        || (dest_parts[NE_] && dest_parts[NW_]);
+
+        bool west = dest_parts[W_]
+        || (dest_parts[NW_] && !dest_parts[N_] && !dest_parts[NE_]);
+
+        bool south = dest_parts[S_]
+        || (dest_parts[SW_]
+            && (!dest_parts[W_] || (!dest_parts[NE_] && dest_parts[SW_])))
+        || (dest_parts[SW_] && dest_parts[SE_]);
+
+        // Note: There are many outport of "Local".
+        // Lookup RoutingTable to find the corressponding outport.
+        bool local = dest_parts[L_];
+
+        // Outport each partition takes among the ones chosen above.
+        std::array<int, NUM_PARTITION> &outport = m_partition_outport[mask];
+        outport.fill(-1);
+        outport[NE_] = north ? outport_north : (east ? outport_east : -1);
+        outport[N_]  = north ? outport_north : -1;
+        outport[NW_] = north ? outport_north : (west ? outport_west : -1);
+        outport[W_]  = west ? outport_west : -1;
+        outport[SW_] = south ? outport_south : (west ? outport_west : -1);
+        outport[S_]  = south ? outport_south : -1;
+        outport[SE_] = south ? outport_south : (east ? outport_east : -1);
+        outport[E_]  = east ? outport_east : -1;
+        outport[L_]  = local ? outport_local : -1;
     }
 
-    if (dest_parts[N_]
-    || (dest_parts[NE_]
-            && (!dest_parts[E_] || (!dest_parts[SW_] && dest_parts[SE_])))
-    || (dest_parts[NE_] && dest_parts[NW_])) {
-        outports.insert(m_outports_dirn2idx["North"]);
+    // XY route and Hamiltonian path step toward every router of the mesh.
+    // The path snakes along the rows: even rows run east, odd rows west.
+    int num_cols = m_router->get_net_ptr()->getNumCols();
+    m_path_label.resize(num_routers);
+    for (int id = 0; id < num_routers; id++) {
+        int x = id % num_cols;
+        int y = id / num_cols;
+        m_path_label[id] = y * num_cols + (y % 2 == 0 ? x : num_cols - 1 - x);
     }
 
-    if (dest_parts[W_]
-    || (dest_parts[NW_] && !dest_parts[N_] && !dest_parts[NE_])) {
-        outports.insert(m_outports_dirn2idx["West"]);
+    int router_id = m_router->get_id();
+    int router_x = router_id % num_cols;
+    int router_y = router_id / num_cols;
+    int my_label = m_path_label[router_id];
+
+    // Neighbors reachable from this router and the outport toward them
+    std::vector<std::pair<int, int>> neighbors;
+    if (outport_east != -1)
+        neighbors.push_back(std::make_pair(router_id + 1, outport_east));
+    if (outport_west != -1)
+        neighbors.push_back(std::make_pair(router_id - 1, outport_west));
+    if (outport_north != -1)
+        neighbors.push_back(std::make_pair(router_id + num_cols,
+                                           outport_north));
+    if (outport_south != -1)
+        neighbors.push_back(std::make_pair(router_id - num_cols,
+                                           outport_south));
+
+    m_xy_outport.resize(num_routers);
+    m_path_outport.resize(num_routers);
+    for (int dest_id = 0; dest_id < num_routers; dest_id++) {
+        int dest_x = dest_id % num_cols;
+        int dest_y = dest_id / num_cols;
+        if (dest_x > router_x) {
+            m_xy_outport[dest_id] = outport_east;
+        } else if (dest_x < router_x) {
+            m_xy_outport[dest_id] = outport_west;
+        } else if (dest_y > router_y) {
+            m_xy_outport[dest_id] = outport_north;
+        } else if (dest_y < router_y) {
+            m_xy_outport[dest_id] = outport_south;
+        } else {
+            m_xy_outport[dest_id] = outport_local;
+        }
+
+        // Go to the neighbor farthest along the path that does not
+        // overshoot the destination.
+        int dest_label = m_path_label[dest_id];
+        int best_label = -1;
+        m_path_outport[dest_id] = dest_label == my_label ? outport_local : -1;
+        for (auto &neighbor : neighbors) {
+            int label = m_path_label[neighbor.first];
+            bool on_path = dest_label > my_label ?
+                (label > my_label && label <= dest_label) :
+                (label < my_label && label >= dest_label);
+            bool farther = best_label == -1 ||
+                std::abs(label - my_label) > std::abs(best_label - my_label);
+            if (dest_label != my_label && on_path && farther) {
+                best_label = label;
+                m_path_outport[dest_id] = neighbor.second;
+            }
+        }
     }
+}
+
+int
+RPMRoutingUnit::lookupOutport(PortDirection dirn)
+{
+    auto it = m_outports_dirn2idx.find(dirn);
+    return it == m_outports_dirn2idx.end() ? -1 : it->second;
+}
 
-    if (dest_parts[S_]
-    || (dest_parts[SW_]
-        && (!dest_parts[W_] || (!dest_parts[NE_] && dest_parts[SW_])))
-    || (dest_parts[SW_] && dest_parts[SE_])) {
-        outports.insert(m_outports_dirn2idx["South"]);
+void
+RPMRoutingUnit::addOutportDests(outport2dests_t &outport2dests,
+        int outport, const Set &dests)
+{
+    auto it = outport2dests.begin();
+    while (it != outport2dests.end() && it->first < outport) {
+        it++;
+    }
+    if (it == outport2dests.end() || it->first != outport) {
+        it = outport2dests.insert(it,
+                std::make_pair(outport, Set(dests.getSize())));
     }
+    it->second.addSet(dests);
+}
 
-    if (dest_parts[L_]) {
-        // Note: There are many outport of "Local".
-        // Lookup RoutingTable to find the corressponding outport.
-        outports.insert(m_outports_dirn2idx["Local"]);
+outport2dests_t
+RPMRoutingUnit::outportComputeRPM(RouteInfo route,
+                PortDirection inport_dirn)
+{
+    assert(!m_partition_of.empty());
+    switch (m_multicast_routing) {
+      case enums::rpm:
+        return outportComputePartition(route);
+      case enums::dual_path:
+        return outportComputeDualPath(route);
+      case enums::xy_tree:
+      case enums::unicast:
+        // A unicast copy is an XY tree with a single leaf
+        return outportComputeXYTree(route);
+      default:
+        panic("Unknown multicast routing %d\n", m_multicast_routing);
+    }
+}
+
+outport2dests_t
+RPMRoutingUnit::outportComputeXYTree(const RouteInfo &route)
+{
+    int num_routers = m_xy_outport.size();
+    outport2dests_t outport2dests;
+    for (auto dest_ni_id : route.net_dest) {
+        int dest_router_id
+            = m_router->get_net_ptr()->get_router_id(dest_ni_id, route.vnet);
+        Set dest(num_routers);
+        dest.add(dest_router_id);
+        addOutportDests(outport2dests, m_xy_outport[dest_router_id], dest);
     }
+    return outport2dests;
+}
 
-    int outport_east  = m_outports_dirn2idx["East"];
-    int outport_west  = m_outports_dirn2idx["West"];
-    int outport_south = m_outports_dirn2idx["South"];
-    int outport_north = m_outports_dirn2idx["North"];
-    int outport_local = m_outports_dirn2idx["Local"];
+outport2dests_t
+RPMRoutingUnit::outportComputeDualPath(const RouteInfo &route)
+{
+    // Destinations above this router on the Hamiltonian path follow the
+    // path toward the nearest of them, and likewise below. The source
+    // splits a multicast so each packet only goes one way.
+    int num_routers = m_path_outport.size();
+    int my_label = m_path_label[m_router->get_id()];
+    Set high(num_routers), low(num_routers), local(num_routers);
+    int next_high = -1, next_low = -1;
+    for (auto dest_ni_id : route.net_dest) {
+        int dest_router_id
+            = m_router->get_net_ptr()->get_router_id(dest_ni_id, route.vnet);
+        int label = m_path_label[dest_router_id];
+        if (label > my_label) {
+            high.add(dest_router_id);
+            if (next_high == -1 || label < m_path_label[next_high])
+                next_high = dest_router_id;
+        } else if (label < my_label) {
+            low.add(dest_router_id);
+            if (next_low == -1 || label > m_path_label[next_low])
+                next_low = dest_router_id;
+        } else {
+            local.add(dest_router_id);
+        }
+    }
 
     outport2dests_t outport2dests;
+    if (next_high != -1) {
+        addOutportDests(outport2dests, m_path_outport[next_high], high);
+    }
+    if (next_low != -1) {
+        addOutportDests(outport2dests, m_path_outport[next_low], low);
+    }
+    if (!local.isEmpty()) {
+        addOutportDests(outport2dests, lookupOutport("Local"), local);
+    }
+    return outport2dests;
+}
 
-    for (auto dest_ni_id : all_dest) {
+outport2dests_t
+RPMRoutingUnit::outportComputePartition(const RouteInfo &route)
+{
+    int num_routers = m_partition_of.size();
+
+    // Step 1
+    // Split the destination routers by partition.
+    std::array<Set, NUM_PARTITION> part_dests;
+    part_dests.fill(Set(num_routers));
+    unsigned mask = 0;
+    for (auto dest_ni_id : route.net_dest) {
         int dest_router_id
             = m_router->get_net_ptr()->get_router_id(dest_ni_id, route.vnet);
-        Partition p = getPartitionOf(dest_router_id);
-        switch (p) {
-            case NE_:
-                if (outports.find(outport_north) != outports.end()) {
-                    outport2dests[outport_north].insert(dest_router_id);
-                } else if (outports.find(outport_east) != outports.end()) {
-                    outport2dests[outport_east].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case N_:
-                if (outports.find(outport_north) != outports.end()) {
-                    outport2dests[outport_north].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case NW_:
-                if (outports.find(outport_north) != outports.end()) {
-                    outport2dests[outport_north].insert(dest_router_id);
-                } else if (outports.find(outport_west) != outports.end()) {
-                    outport2dests[outport_west].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case W_:
-                if (outports.find(outport_west) != outports.end()) {
-                    outport2dests[outport_west].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case SW_:
-                if (outports.find(outport_south) != outports.end()) {
-                    outport2dests[outport_south].insert(dest_router_id);
-                } else if (outports.find(outport_west) != outports.end()) {
-                    outport2dests[outport_west].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case S_:
-                if (outports.find(outport_south) != outports.end()) {
-                    outport2dests[outport_south].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case SE_:
-                if (outports.find(outport_south) != outports.end()) {
-                    outport2dests[outport_south].insert(dest_router_id);
-                } else if (outports.find(outport_east) != outports.end()) {
-                    outport2dests[outport_east].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case E_:
-                if (outports.find(outport_east) != outports.end()) {
-                    outport2dests[outport_east].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            case L_:
-                if (outports.find(outport_local) != outports.end()) {
-                    // NOTE:
-                    // There are many outports of "Local"
-                    // Find a correct outport using RoutingTable
-                    outport2dests[outport_local].insert(dest_router_id);
-                } else {
-                    panic("error");
-                }
-                break;
-            default:
-                panic("check this line");
+        Partition p = m_partition_of[dest_router_id];
+        part_dests[p].add(dest_router_id);
+        mask |= 1 << p;
+    }
+
+    // Step 2
+    // Merge the partitions into the outports the rule table picks.
+    const std::array<int, NUM_PARTITION> &partition_outport =
+        m_partition_outport[mask];
+    outport2dests_t outport2dests;
+    for (int p = 0; p < NUM_PARTITION; p++) {
+        if (!(mask & (1 << p))) {
+            continue;
         }
 
+        int outport = partition_outport[p];
+        panic_if(outport == -1, "No outport for partition %d\n", p);
+        addOutportDests(outport2dests, outport, part_dests[p]);
     }
 
     return outport2dests;
@@ -210,19 +330,34 @@ RPMRoutingUnit::get_inport_dirn(const int inport)
 }
 
 bool
-RPMRoutingUnit::isNorthPartition(std::set<int> dests)
+RPMRoutingUnit::isUpperChannel(const Set &dests)
 {
-    //int num_rows = m_router->get_net_ptr()->getNumRows();
-    int num_cols = m_router->get_net_ptr()->getNumCols();
-
-    int router_id = m_router->get_id();
-    //int router_x = router_id % num_cols;
-    int router_y = router_id / num_cols;
+    switch (m_multicast_routing) {
+      case enums::rpm:
+        return isNorthPartition(dests);
+      case enums::dual_path:
+        // The high path of a dual-path multicast
+        for (int dest_id = 0; dest_id < dests.getSize(); dest_id++) {
+            if (dests.isElement(dest_id) &&
+                m_path_label[dest_id] > m_path_label[m_router->get_id()]) {
+                return true;
+            }
+        }
+        return false;
+      default:
+        return false;
+    }
+}
 
-    for (auto dest_id: dests) {
-        //int dest_x = dest_id % num_cols;
-        int dest_y = dest_id / num_cols;
-        if (dest_y > router_y) {
+bool
+RPMRoutingUnit::isNorthPartition(const Set &dests)
+{
+    for (int dest_id = 0; dest_id < dests.getSize(); dest_id++) {
+        if (!dests.isElement(dest_id)) {
+            continue;
+        }
+        Partition p = m_partition_of[dest_id];
+        if (p == NE_ || p == N_ || p == NW_) {
             return true;
         }
     }
@@ -27,6 +27,10 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <array>
+#include <vector>
+
+#include "enums/MulticastRouting.hh"
 #include "mem/ruby/network/garnet/RoutingUnit.hh"
 #include "mem/ruby/network/garnet/rpm/RPMCommonTypes.hh"
 
@@ -46,6 +50,10 @@ class RPMRoutingUnit : public RoutingUnit
 {
     public:
         RPMRoutingUnit(Router *router);
+
+        // Builds the partition and outport tables. Called once the
+        // router knows its outports.
+        void initRPMTables();
         int outportComputeCustom(RouteInfo route,
                 int inport,
                 PortDirection inport_dirn);
@@ -55,10 +63,39 @@ class RPMRoutingUnit : public RoutingUnit
 
         PortDirection get_outport_dirn(const int outport);
         PortDirection get_inport_dirn(const int inport);
-        bool isNorthPartition(std::set<int> dests);
+        bool isNorthPartition(const Set &dests);
+
+        // Whether a packet the source NI sends to these destinations
+        // travels on the upper half of the vnets
+        bool isUpperChannel(const Set &dests);
 
     private:
+        outport2dests_t outportComputePartition(const RouteInfo &route);
+        outport2dests_t outportComputeXYTree(const RouteInfo &route);
+        outport2dests_t outportComputeDualPath(const RouteInfo &route);
+        void addOutportDests(outport2dests_t &outport2dests,
+                int outport, const Set &dests);
+
         Partition getPartitionOf(int dest_id);
+        int lookupOutport(PortDirection dirn);
+
+        enums::MulticastRouting m_multicast_routing;
+
+        // Partition of every router relative to this one
+        std::vector<Partition> m_partition_of;
+
+        // Outport taken by each partition for every mask of destination
+        // partitions (bit p set if a destination lies in partition p).
+        // -1 if the rules give that partition no outport.
+        std::vector<std::array<int, NUM_PARTITION>> m_partition_outport;
+
+        // Outport of the XY route toward every router
+        std::vector<int> m_xy_outport;
+
+        // Position of every router on the Hamiltonian path and the
+        // outport of the path step toward it
+        std::vector<int> m_path_label;
+        std::vector<int> m_path_outport;
 };
 
 } // namespace garnet
@@ -31,6 +31,8 @@
 
 #include "mem/ruby/network/garnet/rpm/RPMSetAsideBuffer.hh"
 
+#include <algorithm>
+
 namespace gem5
 {
 
@@ -40,21 +42,27 @@ namespace ruby
 namespace garnet
 {
 
-RPMSetAsideBuffer::RPMSetAsideBuffer(
-        int id, PortDirection direction, Router *router)
-    : InputUnit(id, direction, router)
+RPMSetAsideBuffer::RPMSetAsideBuffer(int id, PortDirection direction,
+        Router *router, int depth)
+    : InputUnit(id, direction, router), m_depth(depth), m_credits(depth)
 {
     m_rpm_router = dynamic_cast<RPMRouter*>(router);
     assert(m_rpm_router != nullptr);
+    resetStats();
 }
 
 void
 RPMSetAsideBuffer::insertReplicas(
-        std::vector<ReplicaInfo> replicas)
+        const std::vector<ReplicaInfo> &replicas)
 {
+    assert(has_credits(replicas.size()));
     for (auto replica : replicas) {
+        replica.insertCycle = m_router->curCycle();
         m_rpm_buffer.push_back(replica);
+        m_credits--;
     }
+    m_num_replicas += replicas.size();
+    m_max_occupancy = std::max(m_max_occupancy, m_depth - m_credits);
 }
 
 bool
@@ -63,7 +71,7 @@ RPMSetAsideBuffer::need_stage(
 {
     if (m_rpm_buffer.size() > 0) {
         flit* t_flit = m_rpm_buffer.front().rpmFlit;
-        return t_flit->is_stage(stage, time);
+        return t_flit->get_vc() == invc && t_flit->is_stage(stage, time);
     }
     return false;
 }
@@ -121,7 +129,7 @@ RPMSetAsideBuffer::grant_outvc(int invc, int outvc)
 }
 
 flit*
-RPMSetAsideBuffer::peekTopFlit()
+RPMSetAsideBuffer::peekTopFlit(int vc)
 {
     assert(m_rpm_buffer.size() > 0);
     return m_rpm_buffer.front().rpmFlit;
@@ -143,10 +151,20 @@ RPMSetAsideBuffer::getTopFlit(int vc)
         assert(m_rpm_p2outvc.find(key) != m_rpm_p2outvc.end());
         m_rpm_p2outvc.erase(key);
     }
+    m_wait_cycles += m_router->curCycle() - m_rpm_buffer.front().insertCycle;
     m_rpm_buffer.pop_front();
+    m_credits++;
     return t_flit;
 }
 
+uint64_t
+RPMSetAsideBuffer::get_busy_vcs()
+{
+    if (m_rpm_buffer.empty())
+        return 0;
+    return 1ULL << m_rpm_buffer.front().rpmFlit->get_vc();
+}
+
 bool
 RPMSetAsideBuffer::isReady(int invc, Tick curTime)
 {
@@ -158,6 +176,16 @@ RPMSetAsideBuffer::isReady(int invc, Tick curTime)
     return false;
 }
 
+void
+RPMSetAsideBuffer::resetStats()
+{
+    InputUnit::resetStats();
+    m_num_replicas = 0;
+    m_wait_cycles = 0;
+    m_stall_cycles = 0;
+    m_max_occupancy = m_depth - m_credits;
+}
+
 } // namespace garnet
 } // namespace ruby
 } // namespace gem5
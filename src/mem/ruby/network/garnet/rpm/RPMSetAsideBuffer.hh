@@ -52,21 +52,38 @@ namespace garnet
 class RPMSetAsideBuffer : public InputUnit
 {
     public:
-        RPMSetAsideBuffer(
-                int id, PortDirection direction, Router *router);
+        RPMSetAsideBuffer(int id, PortDirection direction,
+                Router *router, int depth);
         ~RPMSetAsideBuffer() = default;
 
+        // Replicas are inserted by the input units and drained by the
+        // SwitchAllocator, so the buffer has nothing to do on its own.
         void wakeup() {}
 
-        void insertReplicas(std::vector<ReplicaInfo> replicas);
+        void insertReplicas(const std::vector<ReplicaInfo> &replicas);
 
+        // One credit per free slot. An input unit leaves its flit on the
+        // link until the buffer has a credit for every replica it makes.
+        bool has_credits(int num_replicas)
+        { return num_replicas <= m_credits; }
+        void record_stall() { m_stall_cycles++; }
+
+        // Only the VC of the oldest replica requests the switch, so the
+        // allocator sees the replica in its own vnet.
         bool need_stage(int invc, flit_stage stage, Tick time);
         int get_outport(int invc);
         int get_outvc(int invc);
         void grant_outvc(int invc, int outvc);
-        flit* peekTopFlit();
+        flit* peekTopFlit(int vc);
         flit* getTopFlit(int vc);
         bool isReady(int invc, Tick curTime);
+        uint64_t get_busy_vcs();
+
+        double get_replicas() const { return m_num_replicas; }
+        double get_wait_cycles() const { return m_wait_cycles; }
+        double get_stall_cycles() const { return m_stall_cycles; }
+        int get_max_occupancy() const { return m_max_occupancy; }
+        void resetStats();
 
         // This input is nothing to do with the following functions.
         // Not to change the login in SwitchAllocator,
@@ -88,7 +105,14 @@ class RPMSetAsideBuffer : public InputUnit
         std::deque<ReplicaInfo> m_rpm_buffer;
         std::map<std::pair<int,int>, int> m_rpm_p2outvc;
         RPMRouter* m_rpm_router;
-
+        int m_depth;
+        int m_credits;
+
+        // Statistical variables
+        double m_num_replicas;
+        double m_wait_cycles;
+        double m_stall_cycles;
+        int m_max_occupancy;
 
 };
 } // namespace garnet
@@ -116,6 +116,8 @@ ProfilerStats::ProfilerStats(statistics::Group *parent, Profiler *profiler)
       ADD_STAT(delayHistogram, "delay histogram for all message"),
       ADD_STAT(m_outstandReqHistSeqr, ""),
       ADD_STAT(m_outstandReqHistCoalsr, ""),
+      ADD_STAT(m_flushNumHistSeqr,
+               "number of cache lines flushed per CLFLUSH request"),
       ADD_STAT(m_latencyHistSeqr, ""),
       ADD_STAT(m_latencyHistCoalsr, ""),
       ADD_STAT(m_hitLatencyHistSeqr, ""),
@@ -143,6 +145,10 @@ ProfilerStats::ProfilerStats(statistics::Group *parent, Profiler *profiler)
         .init(10)
         .flags(statistics::nozero | statistics::pdf | statistics::oneline);
 
+    m_flushNumHistSeqr
+        .init(10)
+        .flags(statistics::nozero | statistics::pdf | statistics::oneline);
+
     m_latencyHistSeqr
         .init(10)
         .flags(statistics::nozero | statistics::pdf | statistics::oneline);
@@ -403,6 +409,8 @@ Profiler::collateStats()
             if (seq != NULL) {
                 rubyProfilerStats.
                     m_outstandReqHistSeqr.add(seq->getOutstandReqHist());
+                rubyProfilerStats.
+                    m_flushNumHistSeqr.add(seq->getFlushNumHist());
             }
 #if BUILD_GPU
             GPUCoalescer *coal = ctr->getGPUCoalescer();
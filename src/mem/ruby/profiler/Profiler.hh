@@ -175,6 +175,9 @@ class Profiler
         statistics::Histogram m_outstandReqHistSeqr;
         statistics::Histogram m_outstandReqHistCoalsr;
 
+        //! Histogram for the number of lines covered by each CLFLUSH.
+        statistics::Histogram m_flushNumHistSeqr;
+
         //! Histogram for holding latency profile of all requests.
         statistics::Histogram m_latencyHistSeqr;
         statistics::Histogram m_latencyHistCoalsr;
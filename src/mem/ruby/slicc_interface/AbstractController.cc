@@ -135,6 +135,20 @@ AbstractController::profileMsgDelay(uint32_t virtualNetwork, Cycles delay)
     stats.delayVCHistogram[virtualNetwork]->sample(delay);
 }
 
+void
+AbstractController::profileFlushWalkStart()
+{
+    m_flushWalkStart = curCycle();
+}
+
+void
+AbstractController::profileFlushWalkEnd(int lines)
+{
+    stats.flushWalks++;
+    stats.flushWalkLines += lines;
+    stats.flushWalkCycles.sample(curCycle() - m_flushWalkStart);
+}
+
 void
 AbstractController::stallBuffer(MessageBuffer* buf, Addr addr)
 {
@@ -459,12 +473,22 @@ ControllerStats::ControllerStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(fullyBusyCycles,
                "cycles for which number of transistions == max transitions"),
-      ADD_STAT(delayHistogram, "delay_histogram")
+      ADD_STAT(delayHistogram, "delay_histogram"),
+      ADD_STAT(flushWalks, "number of CLFLUSH range walks completed"),
+      ADD_STAT(flushWalkLines, "lines covered by CLFLUSH range walks"),
+      ADD_STAT(flushWalkCycles, "cycles from start to end of each walk")
 {
     fullyBusyCycles
         .flags(statistics::nozero);
     delayHistogram
         .flags(statistics::nozero);
+    flushWalks
+        .flags(statistics::nozero);
+    flushWalkLines
+        .flags(statistics::nozero);
+    flushWalkCycles
+        .init(10)
+        .flags(statistics::nozero);
 }
 
 } // namespace ruby
@@ -221,6 +221,9 @@ class AbstractController : public ClockedObject, public Consumer
     void profileRequest(const std::string &request);
     //! Profiles the delay associated with messages.
     void profileMsgDelay(uint32_t virtualNetwork, Cycles delay);
+    //! Profiles the occupancy of a bank walking its slice of a CLFLUSH range.
+    void profileFlushWalkStart();
+    void profileFlushWalkEnd(int lines);
 
     // Tracks outstanding transactions for latency profiling
     struct TransMapPair { unsigned transaction; unsigned state; Tick time; };
@@ -327,6 +330,7 @@ class AbstractController : public ClockedObject, public Consumer
     const int m_transitions_per_cycle;
     const unsigned int m_buffer_size;
     Cycles m_recycle_latency;
+    Cycles m_flushWalkStart;
     const Cycles m_mandatory_queue_latency;
     bool m_waiting_mem_retry;
 
@@ -401,6 +405,12 @@ class AbstractController : public ClockedObject, public Consumer
         //! cares for
         statistics::Histogram delayHistogram;
         std::vector<statistics::Histogram *> delayVCHistogram;
+
+        //! Range flushes walked by this controller, the lines they
+        //! covered and the cycles each walk kept the controller busy
+        statistics::Scalar flushWalks;
+        statistics::Scalar flushWalkLines;
+        statistics::Histogram flushWalkCycles;
     } stats;
 
 };
@@ -65,6 +65,17 @@ RubyRequest::print(std::ostream& out) const
   out << "]";
 }
 
+NetDest
+RubyRequest::getTrafficDestination(MachineType type) const
+{
+    NetDest dest;
+    for (int id : m_trafficDests) {
+        assert(id < MachineType_base_count(type));
+        dest.add({type, (NodeID)id});
+    }
+    return dest;
+}
+
 bool
 RubyRequest::functionalRead(Packet *pkt)
 {
@@ -44,9 +44,9 @@
 #include <ostream>
 #include <vector>
 
-#include "cpu/global_fnum.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/Message.hh"
 #include "mem/ruby/protocol/PrefetchBit.hh"
@@ -78,6 +78,7 @@ class RubyRequest : public Message
     bool m_htmFromTransaction;
     uint64_t m_htmTransactionUid;
     int m_numFlush;
+    std::vector<int> m_trafficDests;
 
     RubyRequest(Tick curTime, uint64_t _paddr, int _len,
         uint64_t _pc, RubyRequestType _type, RubyAccessMode _access_mode,
@@ -93,10 +94,10 @@ class RubyRequest : public Message
           m_pkt(_pkt),
           m_contextId(_core_id),
           m_htmFromTransaction(false),
-          m_htmTransactionUid(0)
+          m_htmTransactionUid(0),
+          m_numFlush(1)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
-        m_numFlush = global_fnum;
     }
 
     RubyRequest(Tick curTime, uint64_t _paddr, int _len,
@@ -120,10 +121,10 @@ class RubyRequest : public Message
           m_wfid(_proc_id),
           m_instSeqNum(_instSeqNum),
           m_htmFromTransaction(false),
-          m_htmTransactionUid(0)
+          m_htmTransactionUid(0),
+          m_numFlush(1)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
-        m_numFlush = global_fnum;
     }
 
     RubyRequest(Tick curTime, uint64_t _paddr, int _len,
@@ -148,10 +149,10 @@ class RubyRequest : public Message
           m_wfid(_proc_id),
           m_instSeqNum(_instSeqNum),
           m_htmFromTransaction(false),
-          m_htmTransactionUid(0)
+          m_htmTransactionUid(0),
+          m_numFlush(1)
     {
         m_LineAddress = makeLineAddress(m_PhysicalAddress);
-        m_numFlush = global_fnum;
     }
 
     RubyRequest(Tick curTime) : Message(curTime) {}
@@ -166,6 +167,7 @@ class RubyRequest : public Message
     const int& getSize() const { return m_Size; }
     const PrefetchBit& getPrefetch() const { return m_Prefetch; }
     RequestPtr getRequestPtr() const { return m_pkt->req; }
+    NetDest getTrafficDestination(MachineType type) const;
 
     void print(std::ostream& out) const;
     bool functionalRead(Packet *pkt);
@@ -87,6 +87,7 @@ CacheMemory::CacheMemory(const Params &p)
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
     m_use_occupancy = dynamic_cast<replacement_policy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
+    m_set_tag_index = p.tag_index == enums::set_array;
 }
 
 void
@@ -102,6 +103,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tags.resize(m_cache_num_sets * m_cache_assoc, MaxAddr);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -138,13 +140,10 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -156,6 +155,15 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
+    if (m_set_tag_index) {
+        const Addr *tags = &m_tags[cacheSet * m_cache_assoc];
+        for (int i = 0; i < m_cache_assoc; i++) {
+            if (tags[i] == tag)
+                return i;
+        }
+        return -1; // Not found
+    }
+
     auto it = m_tag_index.find(tag);
     if (it != m_tag_index.end())
         return it->second;
@@ -252,16 +260,16 @@ CacheMemory::cacheAvail(Addr address) const
     assert(address == makeLineAddress(address));
 
     int64_t cacheSet = addressToCacheSet(address);
+    const Addr *tags = &m_tags[cacheSet * m_cache_assoc];
 
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
-        if (entry != NULL) {
-            if (entry->m_Address == address ||
-                entry->m_Permission == AccessPermission_NotPresent) {
-                // Already in the cache or we found an empty entry
-                return true;
-            }
-        } else {
+        if (tags[i] == MaxAddr || tags[i] == address) {
+            // An empty way or already in the cache
+            return true;
+        }
+        if (m_cache[cacheSet][i]->m_Permission ==
+            AccessPermission_NotPresent) {
+            // We found an empty entry
             return true;
         }
     }
@@ -304,7 +312,9 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            if (!m_set_tag_index)
+                m_tag_index[address] = i;
+            m_tags[cacheSet * m_cache_assoc + i] = address;
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -341,7 +351,9 @@ CacheMemory::deallocate(Addr address)
     uint32_t way = entry->getWay();
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    if (!m_set_tag_index)
+        m_tag_index.erase(address);
+    m_tags[cache_set * m_cache_assoc + way] = MaxAddr;
 }
 
 // Returns with the physical address of the conflicting cache line
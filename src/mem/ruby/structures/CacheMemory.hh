@@ -186,6 +186,12 @@ class CacheMemory : public SimObject
     std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    // Tag of every way, set after set, MaxAddr for an empty way. With
+    // m_set_tag_index, lookups scan the ways of a set here instead of
+    // going through m_tag_index, which is then left empty.
+    std::vector<Addr> m_tags;
+    bool m_set_tag_index;
+
     std::unordered_map<Addr, AbstractCacheEntry*> fake_cache;
 
 
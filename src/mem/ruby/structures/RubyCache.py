@@ -29,6 +29,11 @@ from m5.proxy import *
 from m5.objects.ReplacementPolicies import *
 from m5.SimObject import SimObject
 
+class RubyCacheTagIndex(Enum): vals = [
+    'hash_map',
+    'set_array',
+    ]
+
 class RubyCache(SimObject):
     type = 'RubyCache'
     cxx_class = 'gem5::ruby::CacheMemory'
@@ -39,6 +44,9 @@ class RubyCache(SimObject):
     replacement_policy = Param.BaseReplacementPolicy(TreePLRURP(), "")
     start_index_bit = Param.Int(6, "index start, default 6 for 64-byte line");
     is_icache = Param.Bool(False, "is instruction only cache");
+    tag_index = Param.RubyCacheTagIndex('hash_map',
+        "How tags are looked up. hash_map: one hash map for the whole "
+        "cache. set_array: scan the contiguous tag array of the set")
     block_size = Param.MemorySize("0B", "block size in bytes. 0 means default RubyBlockSize")
 
     dataArrayBanks = Param.Int(1, "Number of banks for the data array")
@@ -208,6 +208,10 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 void
 RubySystem::memWriteback()
 {
+    // the flush only runs the event queue Ruby itself is on
+    fatal_if(numMainEventQueues > 1, "Ruby cache flushes do not support "
+             "controllers on several event queues\n");
+
     m_cooldown_enabled = true;
 
     // Make the trace so we know what to write back.
@@ -403,6 +407,16 @@ RubySystem::unserialize(CheckpointIn &cp)
     makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
 }
 
+void
+RubySystem::warnParallelFunctional()
+{
+    // the controllers on the other event queues keep running meanwhile
+    if (inParallelMode) {
+        warn_once("Ruby functional accesses are not synchronized with the "
+                  "controllers on other event queues\n");
+    }
+}
+
 void
 RubySystem::init()
 {
@@ -430,6 +444,8 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
+        fatal_if(numMainEventQueues > 1, "Ruby cache warmup does not "
+                 "support controllers on several event queues\n");
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -483,6 +499,8 @@ RubySystem::resetStats()
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
+    warnParallelFunctional();
+
     Addr address(pkt->getAddr());
     Addr line_address = makeLineAddress(address);
 
@@ -599,6 +617,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
+    warnParallelFunctional();
+
     Addr address(pkt->getAddr());
     Addr line_address = makeLineAddress(address);
 
@@ -700,6 +720,8 @@ RubySystem::functionalRead(PacketPtr pkt)
 bool
 RubySystem::functionalWrite(PacketPtr pkt)
 {
+    warnParallelFunctional();
+
     Addr addr(pkt->getAddr());
     Addr line_addr = makeLineAddress(addr);
     AccessPermission access_perm = AccessPermission_NotPresent;
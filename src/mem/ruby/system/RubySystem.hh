@@ -132,6 +132,9 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    // Warn once about functional accesses in a parallel simulation
+    void warnParallelFunctional();
   private:
     // configuration parameters
     static bool m_randomization;
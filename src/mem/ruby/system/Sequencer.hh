@@ -42,8 +42,6 @@
 #define __MEM_RUBY_SYSTEM_SEQUENCER_HH__
 
 #include <iostream>
-#include <list>
-#include <unordered_map>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/MachineType.hh"
@@ -51,6 +49,7 @@
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
 #include "mem/ruby/system/RubyPort.hh"
+#include "mem/ruby/system/SequencerRequestTable.hh"
 #include "params/RubySequencer.hh"
 
 namespace gem5
@@ -59,30 +58,6 @@ namespace gem5
 namespace ruby
 {
 
-struct SequencerRequest
-{
-    PacketPtr pkt;
-    RubyRequestType m_type;
-    RubyRequestType m_second_type;
-    Cycles issue_time;
-    SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
-                     RubyRequestType _m_second_type, Cycles _issue_time)
-                : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
-                  issue_time(_issue_time)
-    {}
-
-    bool functionalWrite(Packet *func_pkt) const
-    {
-        // Follow-up on RubyRequest::functionalWrite
-        // This makes sure the hitCallback won't overrite the value we
-        // expect to find
-        assert(func_pkt->isWrite());
-        return func_pkt->trySatisfyFunctional(pkt);
-    }
-};
-
-std::ostream& operator<<(std::ostream& out, const SequencerRequest& obj);
-
 class Sequencer : public RubyPort
 {
   public:
@@ -146,6 +121,7 @@ class Sequencer : public RubyPort
 
     void recordRequestType(SequencerRequestType requestType);
     statistics::Histogram& getOutstandReqHist() { return m_outstandReqHist; }
+    statistics::Histogram& getFlushNumHist() { return m_flushNumHist; }
 
     statistics::Histogram& getLatencyHist() { return m_latencyHist; }
     statistics::Histogram& getTypeLatencyHist(uint32_t t)
@@ -214,7 +190,7 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    SequencerRequestTable m_RequestTable;
 
     Cycles m_deadlock_threshold;
 
@@ -245,6 +221,9 @@ class Sequencer : public RubyPort
     //! Histogram for number of outstanding requests per cycle.
     statistics::Histogram m_outstandReqHist;
 
+    //! Histogram for the number of lines covered by each CLFLUSH request.
+    statistics::Histogram m_flushNumHist;
+
     //! Histogram for holding latency profile of all requests.
     statistics::Histogram m_latencyHist;
     std::vector<statistics::Histogram *> m_typeLatencyHist;
@@ -277,6 +256,11 @@ class Sequencer : public RubyPort
     std::vector<statistics::Histogram *> m_FirstResponseToCompletionDelayHist;
     std::vector<statistics::Counter> m_IncompleteTimes;
 
+    //! Slots probed per request table insertion, and requests that
+    //! aliased with an outstanding request to the same line.
+    statistics::Histogram m_requestTableProbeLength;
+    statistics::Scalar m_aliasedRequests;
+
     EventFunctionWrapper deadlockCheckEvent;
 
     // support for LL/SC
@@ -111,6 +111,7 @@ class AbstractNode(Cache_Controller):
         self.replTriggerQueue = OrderedTriggerMessageBuffer()
         self.reqRdy = TriggerMessageBuffer()
         self.snpRdy = TriggerMessageBuffer()
+        self.flushQueue = TriggerMessageBuffer()
 
         self.reqOut = MessageBuffer()
         self.rspOut = MessageBuffer()
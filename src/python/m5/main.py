@@ -128,6 +128,11 @@ def parse_options():
     option("--dot-dvfs-config", metavar="FILE", default=None,
         help="Create DOT & pdf outputs of the DVFS configuration" + \
              " [Default: %default]")
+    option("--event-queue", metavar="{list,calendar}",
+        choices=("list", "calendar"), default="list",
+        help="Data structure ordering the events of the main event " \
+             "queues, both service events in the same order " \
+             "[Default: %default]")
 
     # Debugging options
     group("Debugging Options")
@@ -149,6 +154,14 @@ def parse_options():
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
         help="Remote gdb base port (set to 0 to disable listening)")
+    option("--event-trace", metavar="FILE", default=None,
+        help="Record the operations on the main event queues to FILE " \
+             "in the output directory, for replay by the event queue " \
+             "benchmark in src/sim/eventq.test.cc")
+    option("--event-profile", action="store_true", default=False,
+        help="Account the host time of the serviced events to the objects "
+             "that own them, written to event_profile.txt and "
+             "event_profile.json in the output directory at exit")
 
     # Help options
     group("Help Options")
@@ -221,6 +234,7 @@ def main():
     m5.options = options
 
     # Set the main event queue for the main thread.
+    event.setEventQueueBackend(options.event_queue)
     event.mainq = event.getEventQueue(0)
     event.setEventQueue(event.mainq)
 
@@ -345,6 +359,11 @@ def main():
     # tell C++ about output directory
     core.setOutputDir(options.outdir)
 
+    if options.event_trace:
+        event.traceEventQueues(options.event_trace)
+    if options.event_profile:
+        event.profileEventQueues()
+
     # update the system path with elements from the -p option
     sys.path[0:0] = options.path
 
@@ -183,6 +183,47 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
+@_url_factory([ "csv", ])
+def _csvFactory(fn, filter=""):
+    """Output a filtered set of stats as one CSV row per stat dump.
+
+    Meant for scripts driving many simulations that only need a few
+    values from each run. The first dump writes the header line and
+    fixes the columns. Vectors are flattened into name::subname and
+    name::total columns and distributions into name::samples and
+    name::mean. The first column is the current tick.
+
+    Parameters:
+      * filter (str): Regex searched in the full stat name, only
+                      matching stats are written (default: all stats)
+
+    Example:
+      csv://stats.csv?filter='network\\.average_packet_latency'
+
+    """
+
+    return _m5.stats.initColumnar(fn, "csv", filter)
+
+@_url_factory([ "jsonl", ])
+def _jsonlFactory(fn, filter=""):
+    """Output a filtered set of stats as one JSON object per stat dump.
+
+    Same stat selection and naming as the csv output, but each line
+    is a self-contained JSON object mapping stat names to values, so
+    records stay readable if the set of stats changes between dumps.
+    NaN values are written as null.
+
+    Parameters:
+      * filter (str): Regex searched in the full stat name, only
+                      matching stats are written (default: all stats)
+
+    Example:
+      jsonl://stats.jsonl?filter='simTicks|packets_injected'
+
+    """
+
+    return _m5.stats.initColumnar(fn, "jsonl", filter)
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -44,6 +44,9 @@
 #include "pybind11/stl.h"
 
 #include "base/logging.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+#include "sim/event_profile.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -114,6 +117,54 @@ pybind_init_event(py::module_ &m_native)
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
     m.def("getEventQueue", &getEventQueue,
           py::return_value_policy::reference);
+    m.def("setEventQueueBackend", [](const std::string &name) {
+            if (name == "list")
+                setMainEventQueueBackend(EventQueue::List);
+            else if (name == "calendar")
+                setMainEventQueueBackend(EventQueue::Calendar);
+            else
+                fatal("Unknown event queue backend '%s'\n", name);
+        });
+    m.def("traceEventQueues", [](const std::string &filename) {
+            // queue 0 goes to the file itself, queue n to filename.n
+            traceMainEventQueues([filename](uint32_t index) {
+                    std::string name = index == 0 ? filename :
+                        csprintf("%s.%d", filename, index);
+                    return simout.create(name)->stream();
+                });
+        });
+    m.def("profileEventQueues", []() {
+            // one profile per queue, merged and written out at exit
+            static std::vector<std::unique_ptr<EventProfile>> profiles;
+            profileMainEventQueues([](uint32_t index) {
+                    if (profiles.size() <= index)
+                        profiles.resize(index + 1);
+                    if (!profiles[index])
+                        profiles[index].reset(new EventProfile);
+                    return profiles[index].get();
+                });
+
+            // the profiles are shared, so dump them only once however
+            // often profiling is requested
+            static bool registered = false;
+            if (registered)
+                return;
+            registered = true;
+
+            registerExitCallback([]() {
+                    EventProfile total;
+                    for (const auto &profile : profiles) {
+                        if (profile)
+                            total.merge(*profile);
+                    }
+
+                    OutputStream *table = simout.create("event_profile.txt");
+                    OutputStream *json = simout.create("event_profile.json");
+                    total.write(*table->stream(), *json->stream());
+                    simout.close(table);
+                    simout.close(json);
+                });
+        });
 
     py::class_<EventQueue>(m, "EventQueue")
         .def("name",  [](EventQueue *eq) { return eq->name(); })
@@ -66,6 +66,12 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    # Take in what the queues hand to each other during a quantum in the
+    # order of the queue indices, so multi-eventq runs are reproducible.
+    # The queues still share random_mt, so objects that draw from it on
+    # more than one queue make the run irreproducible again.
+    deterministic_quanta = Param.Bool(False,
+            "order cross-queue events and messages by source queue")
 
     full_system = Param.Bool("if this is a full system simulation")
 
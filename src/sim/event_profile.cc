@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profile.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+struct Total
+{
+    std::string name;
+    uint64_t events = 0;
+    uint64_t ns = 0;
+};
+
+typedef std::unordered_map<std::string, Total> TotalMap;
+
+// Suffixes the event wrappers append to the name of their object
+const char *wrapperSuffixes[] = {
+    ".wrapped_function_event", ".wrapped_event" };
+
+/**
+ * Split an event name into the owner and the type of the event. Without
+ * the wrapper suffix, the name up to the last dot is the owner and the
+ * rest the type. A name without a dot is its own owner, the event
+ * description is the type then.
+ */
+void
+splitName(const std::string &name, const char *description,
+          std::string &owner, std::string &type)
+{
+    std::string base = name;
+    for (auto suffix : wrapperSuffixes) {
+        size_t len = std::strlen(suffix);
+        if (base.size() > len &&
+            base.compare(base.size() - len, len, suffix) == 0) {
+            base.resize(base.size() - len);
+            break;
+        }
+    }
+
+    size_t dot = base.rfind('.');
+    if (dot == std::string::npos) {
+        owner = base;
+        type = description;
+    } else {
+        owner = base.substr(0, dot);
+        type = base.substr(dot + 1);
+    }
+}
+
+void
+add(TotalMap &totals, const std::string &name, uint64_t events, uint64_t ns)
+{
+    Total &total = totals[name];
+    total.name = name;
+    total.events += events;
+    total.ns += ns;
+}
+
+std::vector<Total>
+sorted(const TotalMap &totals)
+{
+    std::vector<Total> v;
+    for (const auto &t : totals)
+        v.push_back(t.second);
+    std::sort(v.begin(), v.end(), [](const Total &l, const Total &r) {
+        return l.ns != r.ns ? l.ns > r.ns : l.name < r.name;
+    });
+    return v;
+}
+
+void
+writeTable(std::ostream &os, const char *title,
+           const std::vector<Total> &totals, uint64_t total_ns)
+{
+    ccprintf(os, "\n%s\n", title);
+    ccprintf(os, "%12s %7s %12s %10s  %s\n",
+             "host ms", "share", "events", "ns/event", "name");
+    for (const auto &t : totals) {
+        ccprintf(os, "%12.3f %6.2f%% %12d %10.1f  %s\n",
+                 t.ns / 1e6, total_ns ? 100.0 * t.ns / total_ns : 0.0,
+                 t.events, t.events ? (double)t.ns / t.events : 0.0,
+                 t.name);
+    }
+}
+
+void
+writeString(std::ostream &os, const std::string &s)
+{
+    os << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+void
+writeJson(std::ostream &os, const char *key, const std::vector<Total> &totals)
+{
+    os << "  \"" << key << "\": [";
+    for (size_t i = 0; i < totals.size(); i++) {
+        os << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(os, totals[i].name);
+        os << ", \"events\": " << totals[i].events
+           << ", \"host_ns\": " << totals[i].ns << "}";
+    }
+    os << "\n  ]";
+}
+
+} // anonymous namespace
+
+void
+EventProfile::process(Event *event)
+{
+    Entry &entry = entries[event->name()];
+    if (!entry.description)
+        entry.description = event->description();
+
+    auto start = std::chrono::steady_clock::now();
+    event->process();
+    auto end = std::chrono::steady_clock::now();
+
+    entry.events++;
+    entry.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - start).count();
+}
+
+void
+EventProfile::merge(const EventProfile &other)
+{
+    for (const auto &e : other.entries) {
+        Entry &entry = entries[e.first];
+        entry.events += e.second.events;
+        entry.ns += e.second.ns;
+        entry.description = e.second.description;
+    }
+}
+
+uint64_t
+EventProfile::events() const
+{
+    uint64_t events = 0;
+    for (const auto &e : entries)
+        events += e.second.events;
+    return events;
+}
+
+uint64_t
+EventProfile::hostNs() const
+{
+    uint64_t ns = 0;
+    for (const auto &e : entries)
+        ns += e.second.ns;
+    return ns;
+}
+
+void
+EventProfile::write(std::ostream &table, std::ostream &json) const
+{
+    TotalMap owners;
+    TotalMap types;
+    for (const auto &e : entries) {
+        std::string owner, type;
+        splitName(e.first, e.second.description, owner, type);
+        add(owners, owner, e.second.events, e.second.ns);
+        add(types, type, e.second.events, e.second.ns);
+    }
+
+    std::vector<Total> by_owner = sorted(owners);
+    std::vector<Total> by_type = sorted(types);
+    uint64_t total_events = events();
+    uint64_t total_ns = hostNs();
+
+    ccprintf(table, "Event profile: %d events, %.3f ms host time in "
+             "Event::process()\n", total_events, total_ns / 1e6);
+    writeTable(table, "Host time by owner", by_owner, total_ns);
+    writeTable(table, "Host time by event type", by_type, total_ns);
+
+    json << "{\n  \"events\": " << total_events
+         << ",\n  \"host_ns\": " << total_ns << ",\n";
+    writeJson(json, "owners", by_owner);
+    json << ",\n";
+    writeJson(json, "types", by_type);
+    json << "\n}\n";
+}
+
+} // namespace gem5
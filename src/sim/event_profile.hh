@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Host time profile of the events serviced by an event queue.
+ *
+ * The profile is opt-in: an EventQueue without a profile services its
+ * events as before, one with a profile times the process() call of
+ * every event with the host clock and accounts it to the event's
+ * name. When the profile is written, the names are split into the
+ * object that owns the event and the type of the event, so that the
+ * host time can be broken down both ways.
+ */
+
+#ifndef __SIM_EVENT_PROFILE_HH__
+#define __SIM_EVENT_PROFILE_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+
+namespace gem5
+{
+
+class Event;
+
+class EventProfile
+{
+  public:
+    /** Service the event and account the host time it took. */
+    void process(Event *event);
+
+    /** Add the events accounted by another profile. */
+    void merge(const EventProfile &other);
+
+    /**
+     * Write the host time per owner and per event type, most time
+     * first, as a table and as JSON.
+     */
+    void write(std::ostream &table, std::ostream &json) const;
+
+    uint64_t events() const;
+    uint64_t hostNs() const;
+
+  private:
+    struct Entry
+    {
+        uint64_t events = 0;
+        uint64_t ns = 0;
+        const char *description = nullptr;
+    };
+
+    // Events by name
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILE_HH__
@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -37,10 +38,12 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/event_profile.hh"
 
 namespace gem5
 {
@@ -58,18 +61,63 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+bool deterministicQuanta = false;
+
+static EventQueue::Backend mainEventQueueBackend = EventQueue::List;
+static std::function<std::ostream *(uint32_t)> mainEventQueueTrace;
+static std::function<EventProfile *(uint32_t)> mainEventQueueProfile;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
+        EventQueue *eq =
+            new EventQueue(csprintf("MainEventQueue-%d", index));
+        eq->backend(mainEventQueueBackend);
+        if (mainEventQueueTrace)
+            eq->trace(mainEventQueueTrace(numMainEventQueues));
+        if (mainEventQueueProfile)
+            eq->profile(mainEventQueueProfile(numMainEventQueues));
+
         numMainEventQueues++;
-        mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.push_back(eq);
     }
 
     return mainEventQueue[index];
 }
 
+uint32_t
+curEventQueueIndex()
+{
+    auto it = std::find(mainEventQueue.begin(), mainEventQueue.end(),
+                        curEventQueue());
+    return it - mainEventQueue.begin();
+}
+
+void
+setMainEventQueueBackend(EventQueue::Backend backend)
+{
+    mainEventQueueBackend = backend;
+    for (auto eq : mainEventQueue)
+        eq->backend(backend);
+}
+
+void
+traceMainEventQueues(std::function<std::ostream *(uint32_t)> open)
+{
+    mainEventQueueTrace = open;
+    for (uint32_t i = 0; i < numMainEventQueues; i++)
+        mainEventQueue[i]->trace(open ? open(i) : nullptr);
+}
+
+void
+profileMainEventQueues(std::function<EventProfile *(uint32_t)> get)
+{
+    mainEventQueueProfile = get;
+    for (uint32_t i = 0; i < numMainEventQueues; i++)
+        mainEventQueue[i]->profile(get ? get(i) : nullptr);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -111,6 +159,16 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    if (traceStream) {
+        *traceStream << "s " << event << " " << event->when() << " "
+                     << event->priority() << "\n";
+    }
+
+    if (_backend == Calendar) {
+        calendarInsert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -170,6 +228,14 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (traceStream)
+        *traceStream << "d " << event << "\n";
+
+    if (_backend == Calendar) {
+        calendarRemove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -202,7 +268,12 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (traceStream)
+        *traceStream << "x " << event << "\n";
+
+    if (_backend == Calendar) {
+        calendarPopHead();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -220,7 +291,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (profiler)
+            profiler->process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -235,6 +309,232 @@ EventQueue::serviceOne()
     return NULL;
 }
 
+void
+EventQueue::calendarInsert(Event *event)
+{
+    // The same as insert() on the sorted bin list of the bucket
+    Event *&top = bucket(event->when());
+    if (!top || *event <= *top) {
+        if (!top || *event < *top)
+            numBins++;
+        top = Event::insertBefore(event, top);
+    } else {
+        Event *prev = top;
+        Event *curr = top->nextBin;
+        int walked = 0;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+            walked++;
+        }
+
+        if (!curr || *event < *curr)
+            numBins++;
+        prev->nextBin = Event::insertBefore(event, curr);
+
+        // the buckets are too wide for the events
+        if (walked > MaxBucketWalk)
+            rewidth = true;
+    }
+
+    // an event joining the head bin goes on top of it
+    if (!head || *event <= *head)
+        head = event;
+
+    calendarCheckSize();
+}
+
+void
+EventQueue::calendarRemove(Event *event)
+{
+    Event *&top = bucket(event->when());
+    Event *prev = nullptr;
+    Event *curr = top;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+    }
+
+    if (!curr || *curr != *event)
+        panic("event not found!");
+
+    bool last = event == curr && !event->nextInBin;
+    Event *bin = Event::removeItem(event, curr);
+    if (prev)
+        prev->nextBin = bin;
+    else
+        top = bin;
+
+    // the head bin either gets a new top or is gone
+    if (event == head)
+        head = last ? calendarFindNext(event->when()) : bin;
+
+    if (last) {
+        numBins--;
+        calendarCheckSize();
+    }
+}
+
+void
+EventQueue::calendarPopHead()
+{
+    Event *event = head;
+    Event *&top = bucket(event->when());
+    assert(top == event);
+
+    Event *next = event->nextInBin;
+    if (next) {
+        next->nextBin = event->nextBin;
+        top = head = next;
+        return;
+    }
+
+    top = event->nextBin;
+    numBins--;
+
+    if (event->when() > lastServiced) {
+        gapSum += event->when() - lastServiced;
+        gapCount++;
+    }
+    lastServiced = event->when();
+
+    head = calendarFindNext(event->when());
+    calendarCheckSize();
+}
+
+Event *
+EventQueue::calendarFindNext(Tick when)
+{
+    if (numBins == 0)
+        return nullptr;
+
+    // Walk the buckets from the one of when on, a bucket whose first
+    // bin is in the window being looked at has the first bin overall
+    const size_t mask = buckets.size() - 1;
+    const Tick window = when >> widthShift;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        Event *top = buckets[(window + i) & mask];
+        if (top && (top->when() >> widthShift) == window + i)
+            return top;
+    }
+
+    // Nothing within a whole turn of the calendar, the buckets are too
+    // narrow for the events. Take the smallest bucket head instead.
+    rewidth = true;
+    Event *first = nullptr;
+    for (auto top : buckets) {
+        if (top && (!first || *top < *first))
+            first = top;
+    }
+    return first;
+}
+
+void
+EventQueue::calendarInsertBin(Event *bin)
+{
+    Event *&top = bucket(bin->when());
+    if (!top || *bin < *top) {
+        bin->nextBin = top;
+        top = bin;
+    } else {
+        Event *prev = top;
+        while (prev->nextBin && *prev->nextBin < *bin)
+            prev = prev->nextBin;
+        bin->nextBin = prev->nextBin;
+        prev->nextBin = bin;
+    }
+    numBins++;
+
+    if (!head || *bin < *head)
+        head = bin;
+}
+
+void
+EventQueue::calendarCheckSize()
+{
+    const size_t size = buckets.size();
+    if (numBins > 2 * size)
+        calendarResize(2 * size);
+    else if (size > MinBuckets && numBins < size / 2)
+        calendarResize(size / 2);
+    else if (rewidth && gapCount >= MinGapSamples)
+        calendarResize(size);
+}
+
+void
+EventQueue::calendarResize(size_t size)
+{
+    // A bucket covers about three times the average spacing of the
+    // serviced bins
+    if (gapCount >= MinGapSamples) {
+        Tick gap = gapSum / gapCount;
+        widthShift = gap > MaxTick / 3 ? 62 : ceilLog2(3 * gap);
+    }
+    gapSum = 0;
+    gapCount = 0;
+    rewidth = false;
+
+    std::vector<Event *> old(size, nullptr);
+    old.swap(buckets);
+    numBins = 0;
+
+    // head stays the first bin
+    for (auto top : old) {
+        while (top) {
+            Event *next = top->nextBin;
+            calendarInsertBin(top);
+            top = next;
+        }
+    }
+}
+
+std::vector<Event *>
+EventQueue::bins() const
+{
+    std::vector<Event *> tops;
+    if (_backend == List) {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            tops.push_back(bin);
+        return tops;
+    }
+
+    for (auto top : buckets) {
+        for (Event *bin = top; bin; bin = bin->nextBin)
+            tops.push_back(bin);
+    }
+    std::sort(tops.begin(), tops.end(),
+              [](const Event *l, const Event *r) { return *l < *r; });
+    return tops;
+}
+
+void
+EventQueue::backend(Backend b)
+{
+    if (b == _backend)
+        return;
+
+    // Move the events over as a sorted bin list, which is not a
+    // replacement of the head as far as the trace is concerned
+    std::ostream *os = traceStream;
+    traceStream = nullptr;
+    Event *events = replaceHead(nullptr);
+
+    _backend = b;
+    buckets.clear();
+    if (b == Calendar) {
+        buckets.resize(MinBuckets, nullptr);
+        widthShift = InitialWidthShift;
+    }
+    numBins = 0;
+    lastServiced = 0;
+    gapSum = 0;
+    gapCount = 0;
+    rewidth = false;
+
+    replaceHead(events);
+    traceStream = os;
+}
+
 void
 Event::serialize(CheckpointOut &cp) const
 {
@@ -295,15 +595,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (auto nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -318,8 +615,32 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    std::vector<Event *> tops = bins();
+    if (!tops.empty() && tops.front() != head) {
+        cprintf("head is not the first bin!");
+        head->dump();
+        return false;
+    }
+
+    if (_backend == Calendar) {
+        if (tops.size() != numBins) {
+            cprintf("bin count is %d, found %d bins!", numBins, tops.size());
+            return false;
+        }
+        for (auto top : tops) {
+            Event *first = buckets[(top->when() >> widthShift) &
+                                   (buckets.size() - 1)];
+            while (first && first != top)
+                first = first->nextBin;
+            if (!first) {
+                cprintf("bin in the wrong bucket!");
+                top->dump();
+                return false;
+            }
+        }
+    }
+
+    for (auto nextBin : tops) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -345,8 +666,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -355,8 +674,36 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
-    Event* t = head;
-    head = s;
+    if (traceStream)
+        *traceStream << "h\n";
+
+    if (_backend == List) {
+        Event* t = head;
+        head = s;
+        return t;
+    }
+
+    // Hand out the calendar as a sorted bin list
+    Event *t = nullptr;
+    Event **tail = &t;
+    while (head) {
+        Event *bin = head;
+        bucket(bin->when()) = bin->nextBin;
+        numBins--;
+        head = calendarFindNext(bin->when());
+
+        *tail = bin;
+        tail = &bin->nextBin;
+    }
+    *tail = nullptr;
+
+    for (Event *bin = s; bin; ) {
+        Event *next = bin->nextBin;
+        calendarInsertBin(bin);
+        bin = next;
+    }
+    calendarCheckSize();
+
     return t;
 }
 
@@ -416,15 +763,20 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), _backend(List),
+      widthShift(InitialWidthShift), numBins(0), lastServiced(0),
+      gapSum(0), gapCount(0), rewidth(false), traceStream(nullptr),
+      profiler(nullptr)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
+    uint32_t source = deterministicQuanta ? curEventQueueIndex() : 0;
+
     async_queue_mutex.lock();
-    async_queue.push_back(event);
+    async_queue.emplace_back(event, source);
     async_queue_mutex.unlock();
 }
 
@@ -434,8 +786,17 @@ EventQueue::handleAsyncInsertions()
     assert(this == curEventQueue());
     async_queue_mutex.lock();
 
+    // events from different queues at the same tick and priority would
+    // otherwise be serviced in the order their threads inserted them
+    if (deterministicQuanta) {
+        async_queue.sort([](const std::pair<Event*, uint32_t> &a,
+                            const std::pair<Event*, uint32_t> &b) {
+            return a.second < b.second;
+        });
+    }
+
     while (!async_queue.empty()) {
-        insert(async_queue.front());
+        insert(async_queue.front().first);
         async_queue.pop_front();
     }
 
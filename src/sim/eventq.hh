@@ -43,6 +43,8 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -56,6 +58,7 @@ namespace gem5
 {
 
 class EventQueue;       // forward declaration
+class EventProfile;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -79,6 +82,12 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Whether what one queue hands to another during a quantum is taken
+//! in ordered by the index of the sending queue instead of the order
+//! the threads got there, which makes multiple eventq simulation
+//! reproducible from run to run.
+extern bool deterministicQuanta;
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -86,6 +95,10 @@ extern bool inParallelMode;
 EventQueue *getEventQueue(uint32_t index);
 
 inline EventQueue *curEventQueue() { return _curEventQueue; }
+
+//! Index of the current event queue in mainEventQueue, or
+//! numMainEventQueues if the thread does not run a main event queue.
+uint32_t curEventQueueIndex();
 inline void curEventQueue(EventQueue *q);
 
 /**
@@ -621,6 +634,26 @@ operator!=(const Event &l, const Event &r)
  */
 class EventQueue
 {
+  public:
+    /**
+     * The data structure holding the bins of a queue. Both keep the
+     * same (when, priority) order and the same LIFO order within a
+     * bin, so they service events in exactly the same order.
+     */
+    enum Backend
+    {
+        /** A sorted list of bins, insertion walks the list. */
+        List,
+        /**
+         * A calendar queue: the bins are hashed by tick into buckets
+         * of sorted bin lists that cover a power of two ticks each.
+         * The bucket count follows the number of bins and the bucket
+         * width follows the spacing of the serviced events, which
+         * makes insertion and removal constant time on average.
+         */
+        Calendar
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -628,11 +661,41 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    Backend _backend;
+
+    //! Calendar backend state: the bucket heads, log2 of the ticks
+    //! covered by a bucket and the number of bins in the buckets.
+    std::vector<Event *> buckets;
+    int widthShift;
+    size_t numBins;
+
+    //! Spacing of the serviced bins since the last resize, used to
+    //! pick the bucket width.
+    Tick lastServiced;
+    Tick gapSum;
+    uint64_t gapCount;
+
+    //! The bucket width no longer fits the events, resize at the next
+    //! opportunity.
+    bool rewidth;
+
+    static constexpr size_t MinBuckets = 16;
+    static constexpr int InitialWidthShift = 10;
+    static constexpr uint64_t MinGapSamples = 16;
+    static constexpr int MaxBucketWalk = 16;
+
+    //! Stream recording the queue operations, see trace().
+    std::ostream *traceStream;
+
+    //! Host time profile of the serviced events, see profile().
+    EventProfile *profiler;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! List of events added by other threads to this event queue, with
+    //! the index of the queue that added them.
+    std::list<std::pair<Event*, uint32_t>> async_queue;
 
     /**
      * Lock protecting event handling.
@@ -661,6 +724,32 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    Event *&
+    bucket(Tick when)
+    {
+        return buckets[(when >> widthShift) & (buckets.size() - 1)];
+    }
+
+    //! Calendar backend versions of insert(), remove() and popping the
+    //! head event.
+    void calendarInsert(Event *event);
+    void calendarRemove(Event *event);
+    void calendarPopHead();
+
+    //! First bin of the calendar, none of which may be before when.
+    Event *calendarFindNext(Tick when);
+
+    //! Add a whole bin to the calendar.
+    void calendarInsertBin(Event *bin);
+
+    //! Grow, shrink or rewidth the calendar when the bins no longer
+    //! fit it.
+    void calendarCheckSize();
+    void calendarResize(size_t size);
+
+    //! The top events of all bins in order.
+    std::vector<Event *> bins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -747,6 +836,29 @@ class EventQueue
      */
     EventQueue(const std::string &n);
 
+    Backend backend() const { return _backend; }
+
+    /**
+     * Switch the queue to another backend, the scheduled events are
+     * moved over. Should be called only from the owning thread.
+     */
+    void backend(Backend b);
+
+    /**
+     * Record the operations on this queue to the stream, or stop
+     * recording if it is null. There is one line per operation: "s
+     * <event> <when> <priority>" when an event is inserted, "d <event>"
+     * when it is removed, "x <event>" when it is serviced and "h" when
+     * the head is replaced. Events are identified by their address.
+     */
+    void trace(std::ostream *os) { traceStream = os; }
+
+    /**
+     * Account the host time of the serviced events to the profile, or
+     * stop profiling if it is null.
+     */
+    void profile(EventProfile *p) { profiler = p; }
+
     /**
      * @ingroup api_eventq
      * @{
@@ -984,6 +1096,27 @@ curEventQueue(EventQueue *q)
 
 void dumpMainQueue();
 
+/**
+ * Select the backend of the main event queues. Existing queues are
+ * switched over and later ones are created with it.
+ */
+void setMainEventQueueBackend(EventQueue::Backend backend);
+
+/**
+ * Record the operations on the main event queues, see
+ * EventQueue::trace(). The function opens the stream for the queue
+ * with the given index, it is called for existing queues and for
+ * queues created later.
+ */
+void traceMainEventQueues(std::function<std::ostream *(uint32_t)> open);
+
+/**
+ * Profile the main event queues, see EventQueue::profile(). The
+ * function returns the profile of the queue with the given index, it is
+ * called for existing queues and for queues created later.
+ */
+void profileMainEventQueues(std::function<EventProfile *(uint32_t)> get);
+
 class EventManager
 {
   protected:
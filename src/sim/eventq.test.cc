@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2026 The gem5 contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/event_profile.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An event that logs its id when it is serviced. */
+class LogEvent : public Event
+{
+  public:
+    LogEvent(int _id, std::vector<int> &_log, Priority p)
+        : Event(p), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+  private:
+    int id;
+    std::vector<int> &log;
+};
+
+/**
+ * Drive a queue with a random mix of schedules, reschedules,
+ * deschedules and services. Ticks and priorities are drawn from small
+ * ranges so that many events share a bin, now and then an event goes
+ * far out. Returns the ids of the serviced events in order.
+ */
+std::vector<int>
+runRandom(EventQueue::Backend backend, int ops, unsigned seed)
+{
+    const Event::Priority priorities[] = {
+        Event::Minimum_Pri, Event::Default_Pri - 1, Event::Default_Pri,
+        Event::Default_Pri + 1, Event::Maximum_Pri };
+
+    std::vector<int> log;
+    std::mt19937 rng(seed);
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < 512; i++)
+        events.emplace_back(new LogEvent(i, log, priorities[rng() % 5]));
+
+    EventQueue eq("test");
+    eq.backend(backend);
+
+    for (int i = 0; i < ops; i++) {
+        LogEvent *event = events[rng() % events.size()].get();
+        Tick when = eq.getCurTick() + (rng() % 16) * 500;
+        if (rng() % 64 == 0)
+            when += (rng() % 1000) * 100000;
+
+        switch (rng() % 4) {
+          case 0:
+            if (!event->scheduled())
+                eq.schedule(event, when);
+            break;
+          case 1:
+            eq.reschedule(event, when, true);
+            break;
+          case 2:
+            if (event->scheduled())
+                eq.deschedule(event);
+            break;
+          default:
+            if (!eq.empty())
+                eq.serviceOne();
+            break;
+        }
+
+        if (i % 1024 == 0) {
+            EXPECT_TRUE(eq.debugVerify());
+        }
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+    return log;
+}
+
+/**
+ * A trace of queue operations, see EventQueue::trace(). The events are
+ * mapped to slots that each stand for one (address, priority) pair, so
+ * that an address that is reused for an event with another priority
+ * gets an event of its own.
+ */
+class Trace
+{
+  public:
+    explicit Trace(std::istream &is)
+    {
+        std::unordered_map<std::string, int> current;
+        std::string line;
+        while (std::getline(is, line)) {
+            std::istringstream ls(line);
+            Op op;
+            std::string addr;
+            ls >> op.type;
+            if (op.type != 'h')
+                ls >> addr;
+
+            if (op.type == 's') {
+                int prio;
+                ls >> op.when >> prio;
+                auto it = current.find(addr);
+                if (it == current.end() || priorities[it->second] != prio) {
+                    priorities.push_back(prio);
+                    current[addr] = priorities.size() - 1;
+                }
+                op.slot = current[addr];
+            } else if (op.type == 'd' || op.type == 'x') {
+                auto it = current.find(addr);
+                assert(it != current.end());
+                op.slot = it->second;
+            }
+            ops.push_back(op);
+        }
+    }
+
+    size_t size() const { return ops.size(); }
+
+    /**
+     * Replay the trace on a queue with the given backend. Returns the
+     * time taken and checks that every event is serviced in the order
+     * of the trace.
+     */
+    std::chrono::duration<double, std::nano>
+    replay(EventQueue::Backend backend) const
+    {
+        class ReplayEvent : public Event
+        {
+          public:
+            ReplayEvent(Priority p) : Event(p) {}
+            void process() override {}
+        };
+
+        std::vector<std::unique_ptr<ReplayEvent>> events;
+        for (auto prio : priorities)
+            events.emplace_back(new ReplayEvent(prio));
+
+        EventQueue eq("replay");
+        eq.backend(backend);
+        Event *replaced = nullptr;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto &op : ops) {
+            switch (op.type) {
+              case 's':
+                eq.schedule(events[op.slot].get(), op.when);
+                break;
+              case 'd':
+                eq.deschedule(events[op.slot].get());
+                break;
+              case 'x':
+                EXPECT_EQ(eq.getHead(), events[op.slot].get());
+                eq.serviceOne();
+                break;
+              case 'h':
+                // the Ruby cache warmup swaps the head out and back in
+                replaced = eq.replaceHead(replaced);
+                break;
+            }
+        }
+        std::chrono::duration<double, std::nano> time =
+            std::chrono::steady_clock::now() - start;
+
+        if (replaced)
+            eq.replaceHead(replaced);
+        while (!eq.empty())
+            eq.deschedule(eq.getHead());
+        return time;
+    }
+
+  private:
+    struct Op
+    {
+        char type = 0;
+        int slot = 0;
+        Tick when = 0;
+    };
+
+    std::vector<Op> ops;
+    std::vector<Event::Priority> priorities;
+};
+
+/**
+ * A clocked object that wakes up every cycle and now and then arms a
+ * timeout, which it cancels when it is still pending a few cycles later.
+ */
+class Clocked : public Event
+{
+  public:
+    Clocked(EventQueue &_eq, Tick _period, unsigned seed)
+        : eq(_eq), period(_period), rng(seed),
+          timeout([] {}, "timeout", false, Event::CPU_Tick_Pri)
+    {}
+
+    void
+    process() override
+    {
+        Tick now = eq.getCurTick();
+        eq.schedule(this, now + period);
+        if (timeout.scheduled() && rng() % 4 == 0)
+            eq.deschedule(&timeout);
+        else if (!timeout.scheduled() && rng() % 8 == 0)
+            eq.schedule(&timeout, now + (rng() % 100) * period);
+    }
+
+    ~Clocked()
+    {
+        if (timeout.scheduled())
+            eq.deschedule(&timeout);
+    }
+
+  private:
+    EventQueue &eq;
+    Tick period;
+    std::mt19937 rng;
+    EventFunctionWrapper timeout;
+};
+
+/**
+ * Record the trace of a few thousand clocked objects in three clock
+ * domains, roughly what the controllers and routers of a large Ruby
+ * system do to the queue.
+ */
+std::string
+recordClockedTrace(Tick ticks)
+{
+    std::ostringstream os;
+    EventQueue eq("record");
+    eq.trace(&os);
+
+    std::vector<std::unique_ptr<Clocked>> objects;
+    const Tick periods[] = { 333, 500, 1000 };
+    for (int i = 0; i < 3000; i++) {
+        Tick period = periods[i % 3];
+        objects.emplace_back(new Clocked(eq, period, i));
+        eq.schedule(objects.back().get(), period * (1 + i % 7));
+    }
+
+    eq.serviceEvents(ticks);
+    while (!eq.empty())
+        eq.deschedule(eq.getHead());
+    return os.str();
+}
+
+} // anonymous namespace
+
+TEST(EventQueueTest, CalendarMatchesList)
+{
+    for (unsigned seed = 1; seed <= 4; seed++) {
+        std::vector<int> list = runRandom(EventQueue::List, 100000, seed);
+        std::vector<int> calendar =
+            runRandom(EventQueue::Calendar, 100000, seed);
+        ASSERT_FALSE(list.empty());
+        ASSERT_EQ(list, calendar);
+    }
+}
+
+TEST(EventQueueTest, SwitchBackend)
+{
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    EventQueue eq("test");
+    for (int i = 0; i < 100; i++) {
+        events.emplace_back(new LogEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), (i % 10) * 1000);
+    }
+
+    // events of a bin come out last scheduled first, across a switch too
+    eq.backend(EventQueue::Calendar);
+    ASSERT_TRUE(eq.debugVerify());
+    for (int i = 0; i < 50; i++)
+        eq.serviceOne();
+    eq.backend(EventQueue::List);
+    ASSERT_TRUE(eq.debugVerify());
+    while (!eq.empty())
+        eq.serviceOne();
+
+    ASSERT_EQ(log.size(), 100);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(log[i], (i / 10) + 10 * (9 - i % 10));
+}
+
+TEST(EventQueueTest, ReplaceHead)
+{
+    std::vector<int> log;
+    std::vector<std::unique_ptr<LogEvent>> events;
+    EventQueue eq("test");
+    eq.backend(EventQueue::Calendar);
+    for (int i = 0; i < 4; i++)
+        events.emplace_back(new LogEvent(i, log, Event::Default_Pri));
+
+    eq.schedule(events[0].get(), 2000);
+    eq.schedule(events[1].get(), 1000);
+
+    // run other events with the scheduled ones out of the way
+    Event *saved = eq.replaceHead(nullptr);
+    ASSERT_TRUE(eq.empty());
+    eq.schedule(events[2].get(), 1500);
+    eq.serviceOne();
+    ASSERT_TRUE(eq.empty());
+
+    eq.replaceHead(saved);
+    ASSERT_TRUE(eq.debugVerify());
+    eq.schedule(events[3].get(), 2000);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    ASSERT_EQ(log, std::vector<int>({2, 1, 3, 0}));
+}
+
+TEST(EventQueueTest, Profile)
+{
+    EventProfile profile;
+    EventQueue eq("test");
+    eq.profile(&profile);
+
+    std::vector<int> log;
+    LogEvent plain(0, log, Event::Default_Pri);
+    EventFunctionWrapper tick([] {}, "system.cpu.tick");
+    EventFunctionWrapper fetch([] {}, "system.cpu.fetch");
+    EventFunctionWrapper l1([] {}, "system.l1.tick");
+
+    eq.schedule(&plain, 100);
+    eq.schedule(&tick, 100);
+    eq.schedule(&fetch, 200);
+    eq.schedule(&l1, 300);
+    eq.serviceEvents(300);
+    eq.schedule(&tick, 400);
+    eq.serviceEvents(400);
+
+    ASSERT_EQ(log.size(), 1);
+    ASSERT_EQ(profile.events(), 5);
+
+    std::ostringstream table, json;
+    profile.write(table, json);
+    std::string out = json.str();
+
+    // the wrapper suffix is dropped, the rest splits at the last dot
+    ASSERT_NE(out.find("{\"name\": \"system.cpu\", \"events\": 3"),
+              std::string::npos);
+    ASSERT_NE(out.find("{\"name\": \"system.l1\", \"events\": 1"),
+              std::string::npos);
+    ASSERT_NE(out.find("{\"name\": \"tick\", \"events\": 3"),
+              std::string::npos);
+    ASSERT_NE(out.find("{\"name\": \"fetch\", \"events\": 1"),
+              std::string::npos);
+    // events named without a dot are typed by their description
+    ASSERT_NE(out.find("{\"name\": \"generic\", \"events\": 1"),
+              std::string::npos);
+}
+
+/**
+ * Microbenchmark of the backends on a recorded trace. The trace of a
+ * real run, recorded with --event-trace, is taken from the file in the
+ * EVENTQ_TRACE environment variable, a synthetic one is recorded
+ * otherwise. The timings are only printed since they depend on the
+ * host.
+ */
+TEST(EventQueueTest, Benchmark)
+{
+    std::unique_ptr<Trace> trace;
+    if (const char *path = std::getenv("EVENTQ_TRACE")) {
+        std::ifstream is(path);
+        ASSERT_TRUE(is.good()) << "cannot open " << path;
+        trace.reset(new Trace(is));
+    } else {
+        std::istringstream is(recordClockedTrace(100000));
+        trace.reset(new Trace(is));
+    }
+    ASSERT_GT(trace->size(), 0);
+
+    auto list_time = trace->replay(EventQueue::List);
+    auto calendar_time = trace->replay(EventQueue::Calendar);
+
+    std::cout << "trace:    " << trace->size() << " operations" << std::endl;
+    std::cout << "List:     " << list_time.count() / trace->size()
+              << " ns/op" << std::endl;
+    std::cout << "Calendar: " << calendar_time.count() / trace->size()
+              << " ns/op" << std::endl;
+}
@@ -36,6 +36,8 @@ namespace gem5
 
 std::mutex BaseGlobalEvent::globalQMutex;
 
+static std::vector<std::vector<std::function<void()>>> quantumCallbacks;
+
 BaseGlobalEvent::BaseGlobalEvent(Priority p, Flags f)
     : barrier(numMainEventQueues),
       barrierEvent(numMainEventQueues, NULL)
@@ -148,6 +150,9 @@ GlobalSyncEvent::BarrierEvent::process()
         _globalEvent->process();
     }
 
+    // every queue is stopped until the second barrier
+    processQuantumCallbacks(curEventQueueIndex());
+
     // second barrier to force all queues to wait for event processing
     // to finish before continuing
     globalBarrier();
@@ -168,4 +173,22 @@ GlobalSyncEvent::description() const
     return "GlobalSyncEvent";
 }
 
+void
+registerQuantumCallback(uint32_t queue, std::function<void()> callback)
+{
+    if (quantumCallbacks.size() <= queue)
+        quantumCallbacks.resize(queue + 1);
+    quantumCallbacks[queue].push_back(callback);
+}
+
+void
+processQuantumCallbacks(uint32_t queue)
+{
+    if (queue >= quantumCallbacks.size())
+        return;
+
+    for (auto &callback : quantumCallbacks[queue])
+        callback();
+}
+
 } // namespace gem5
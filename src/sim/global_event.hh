@@ -30,6 +30,7 @@
 #ifndef __SIM_GLOBAL_EVENT_HH__
 #define __SIM_GLOBAL_EVENT_HH__
 
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -236,6 +237,19 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     Tick repeat;
 };
 
+/**
+ * Register a function to be called at every GlobalSyncEvent barrier
+ * (the simulation quantum) by the thread of the given main event
+ * queue, and once more for every queue when the simulation loop
+ * exits. All queues are stopped when it runs, so it may take in what
+ * the other queues left for this one during the quantum, as long as
+ * it only schedules events on its own queue.
+ */
+void registerQuantumCallback(uint32_t queue, std::function<void()> callback);
+
+/** Call the quantum callbacks of the given main event queue. */
+void processQuantumCallbacks(uint32_t queue);
+
 } // namespace gem5
 
 #endif // __SIM_GLOBAL_EVENT_HH__
@@ -189,7 +189,7 @@ void
 m5setNumFlush(ThreadContext *tc, uint64_t num)
 {
     DPRINTF(PseudoInst, "pseudo_inst::m5setNumFlush(%d)\n", num);
-    tc->getCpuPtr()->set_fnum(num);
+    tc->getCpuPtr()->setNumFlush(tc->threadId(), num);
 }
 
 // m5sum is for sanity checking the gem5 op interface.
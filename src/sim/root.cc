@@ -187,6 +187,7 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    deterministicQuanta = p.deterministic_quanta;
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -51,6 +51,7 @@
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
+#include "sim/global_event.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/stat_control.hh"
@@ -73,7 +74,8 @@ class SimulatorThreads
     SimulatorThreads(uint32_t num_queues)
         : terminate(false),
           numQueues(num_queues),
-          barrier(num_queues)
+          barrier(num_queues),
+          exitBarrier(num_queues)
     {
         threads.reserve(num_queues);
     }
@@ -114,6 +116,18 @@ class SimulatorThreads
         barrier.wait();
     }
 
+    /**
+     * Wait until the subordinate threads have left their simulation
+     * loop too. Called from the main thread once its own loop has
+     * returned, so it can work on the other queues undisturbed.
+     */
+    void
+    waitForLocalExit()
+    {
+        if (!threads.empty())
+            exitBarrier.wait();
+    }
+
     void
     terminateThreads()
     {
@@ -155,6 +169,7 @@ class SimulatorThreads
 
         while (!terminate) {
             doSimLoop(queue);
+            exitBarrier.wait();
             barrier.wait();
         }
     }
@@ -163,6 +178,8 @@ class SimulatorThreads
     uint32_t numQueues;
     std::vector<std::thread> threads;
     Barrier barrier;
+    /** Passed by all threads once they have left the simulation loop */
+    Barrier exitBarrier;
 };
 
 static std::unique_ptr<SimulatorThreads> simulatorThreads;
@@ -220,6 +237,18 @@ simulate(Tick num_cycles)
 
     inParallelMode = false;
 
+    // hand over what crossed between the queues since the last quantum,
+    // once the other threads have left their loops and are waiting on
+    // their barrier
+    if (numMainEventQueues > 1) {
+        simulatorThreads->waitForLocalExit();
+        for (uint32_t i = 0; i < numMainEventQueues; i++) {
+            curEventQueue(mainEventQueue[i]);
+            processQuantumCallbacks(i);
+        }
+        curEventQueue(mainEventQueue[0]);
+    }
+
     // locate the global exit event and return it to Python
     BaseGlobalEvent *global_event = local_event->globalEvent();
     assert(global_event);
@@ -67,6 +67,18 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
 )
 
+# Default parameters: one destination, unicast only
+gem5_verify_config(
+    name='garnet_synth_traffic_default',
+    fixtures=(),
+    verifiers=(),
+    config=joinpath(config.base_dir, 'configs',
+        'example', 'garnet_synth_traffic.py'),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    valid_hosts=constants.supported_hosts,
+)
+
 null_tests = [
     ('garnet_synth_traffic', ['--sim-cycles', '5000000']),
     ('memcheck', ['--maxtick', '2000000000', '--prefetchers']),